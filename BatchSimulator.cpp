@@ -0,0 +1,291 @@
+/*
+This is the implementation file corresponding to BatchSimulator.h containing the definitions of the member functions.
+*/
+
+#include "BatchSimulator.h"
+
+#include <cstddef>
+
+#if defined(__GNUC__) && defined(__x86_64__) //GCC and Clang compile the AVX2 functions without -mavx2,
+#define BATCH_SIMULATOR_AVX2 //and they are only called once hasAvx2 found AVX2 at run time
+#include <immintrin.h>
+#endif
+
+const int VECTOR_PLAYERS = 8; //Players moved at a time by stepVectorized, one per 32-bit lane
+
+BatchSimulator::BatchSimulator(const MazeInterface& maze, int numPlayers)
+	: numPaths(maze.getNumPaths()), numNodeIds(maze.getNodeIdLimit()), numPlayers(numPlayers > 0 ? numPlayers : 0),
+		vectorized(hasAvx2())
+{
+	nextNodes = new int[static_cast<size_t>(numNodeIds) * numPaths];
+	nodeInfo = new int[numNodeIds];
+	startId = maze.writeNodeTables(nextNodes, nodeInfo);
+	if (startId < 0) //The maze was rejected, so there is no one to move
+		this->numPlayers = 0;
+
+	nodeIds = new int[this->numPlayers];
+	lives = new int[this->numPlayers];
+	coins = new int[this->numPlayers];
+	powers = new int[this->numPlayers];
+	wordsPerPlayer = (numNodeIds + 31) / 32;
+	collectedBits = new uint32_t[static_cast<size_t>(this->numPlayers) * wordsPerPlayer];
+	collectedLog = new int[static_cast<size_t>(this->numPlayers) * COLLECTED_LOG_SIZE];
+	numCollected = new int[this->numPlayers];
+	for (size_t i = 0; i < static_cast<size_t>(this->numPlayers) * wordsPerPlayer; ++i)
+		collectedBits[i] = 0;
+	for (int player = 0; player < this->numPlayers; ++player)
+		numCollected[player] = 0;
+	startOverAll();
+}
+
+BatchSimulator::~BatchSimulator()
+{
+	delete [] nextNodes;
+	delete [] nodeInfo;
+	delete [] nodeIds;
+	delete [] lives;
+	delete [] coins;
+	delete [] powers;
+	delete [] collectedBits;
+	delete [] collectedLog;
+	delete [] numCollected;
+}
+
+void BatchSimulator::step(const int* pathIndices, MoveOutcome* outcomes)
+{
+	int firstPlayer = 0;
+	if (vectorized)
+		firstPlayer = stepVectorized(0, numPlayers, pathIndices, outcomes);
+
+	stepScalar(firstPlayer, numPlayers, pathIndices, outcomes); //The players left over
+}
+
+int BatchSimulator::stepScalar(int firstPlayer, int lastPlayer, const int* pathIndices, MoveOutcome* outcomes)
+{
+	for (int player = firstPlayer; player < lastPlayer; ++player)
+	{
+		int pathIndex = pathIndices[player];
+		MoveOutcome outcome = MOVE_INVALID;
+
+		if (0 <= pathIndex && pathIndex < numPaths)
+		{
+			int nextNode = nextNodes[nodeIds[player] * numPaths + pathIndex];
+			if (nextNode >= 0) //Valid movement
+			{
+				nodeIds[player] = nextNode; //Move the player
+				uint32_t word = collectedBits[static_cast<size_t>(player) * wordsPerPlayer + (nextNode >> 5)];
+				int prize = (((word >> (nextNode & 31)) & 1) ? 0 : nodeInfo[nextNode] & (NODE_TABLE_FINISH - 1));
+				coins[player] += (prize == 1);
+				powers[player] += (prize == 2);
+
+				if (!(nodeInfo[nextNode] & NODE_TABLE_FINISH)) //Player did not reach the finish
+				{
+					outcome = MOVE_SUCCESSFUL;
+					if (prize > 0)
+						collect(player, nextNode);
+				}
+				else //The prize of the finish is given every time, as in movePlayer
+					outcome = MOVE_FINISH;
+			}
+			else if (pathIndex > 0) //Dead end, > 0 accounts for the case where player moves
+			{			//backwards from the starting position
+				if (lives[player] > 0) //Lives do not go below 0, as in Player::decrementQuantity
+					lives[player]--;
+				outcome = (lives[player] == 0 ? MOVE_GAME_OVER : MOVE_DEAD_END);
+			}
+			else //Player tries to move backwards, but they are at the start so they can't
+				outcome = MOVE_AT_START;
+		}
+
+		if (outcomes)
+			outcomes[player] = outcome;
+	}
+
+	return lastPlayer;
+}
+
+#ifdef BATCH_SIMULATOR_AVX2
+
+__attribute__((target("avx2")))
+int BatchSimulator::stepVectorized(int firstPlayer, int lastPlayer, const int* pathIndices, MoveOutcome* outcomes)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i minusOne = _mm256_set1_epi32(-1);
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i two = _mm256_set1_epi32(2);
+	const __m256i prizeMask = _mm256_set1_epi32(NODE_TABLE_FINISH - 1);
+	const __m256i finishFlag = _mm256_set1_epi32(NODE_TABLE_FINISH);
+	const __m256i pathCount = _mm256_set1_epi32(numPaths);
+	const __m256i bitIndexMask = _mm256_set1_epi32(31);
+	const __m256i rowOffsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+		_mm256_set1_epi32(wordsPerPlayer)); //Offset of the row of each lane in collectedBits
+
+	int player = firstPlayer;
+	for (; player + VECTOR_PLAYERS <= lastPlayer; player += VECTOR_PLAYERS)
+	{
+		__m256i pathIndex = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pathIndices + player));
+		__m256i nodeId = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nodeIds + player));
+
+		//The lanes are all ones where a condition holds, and the gathers only read the lanes of their mask
+		__m256i isValid = _mm256_and_si256(_mm256_cmpgt_epi32(pathIndex, minusOne), _mm256_cmpgt_epi32(pathCount, pathIndex));
+		__m256i linkIndex = _mm256_add_epi32(_mm256_mullo_epi32(nodeId, pathCount), pathIndex);
+		__m256i nextNode = _mm256_mask_i32gather_epi32(minusOne, nextNodes, linkIndex, isValid, 4);
+		__m256i hasMoved = _mm256_cmpgt_epi32(nextNode, minusOne);
+
+		__m256i info = _mm256_mask_i32gather_epi32(zero, nodeInfo, nextNode, hasMoved, 4);
+		__m256i prize = _mm256_and_si256(info, prizeMask);
+		__m256i isFinish = _mm256_cmpeq_epi32(_mm256_and_si256(info, finishFlag), finishFlag);
+		__m256i hasPrize = _mm256_cmpgt_epi32(prize, zero);
+
+		const uint32_t* rows = collectedBits + static_cast<size_t>(player) * wordsPerPlayer;
+		__m256i word = _mm256_mask_i32gather_epi32(zero, reinterpret_cast<const int*>(rows),
+			_mm256_add_epi32(rowOffsets, _mm256_srli_epi32(nextNode, 5)), hasPrize, 4);
+		__m256i isCollected = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_srlv_epi32(word,
+			_mm256_and_si256(nextNode, bitIndexMask)), one), one);
+		prize = _mm256_andnot_si256(isCollected, prize);
+		hasPrize = _mm256_andnot_si256(isCollected, hasPrize);
+
+		__m256i* coinsPtr = reinterpret_cast<__m256i*>(coins + player); //Adding the all ones of a true
+		__m256i* powersPtr = reinterpret_cast<__m256i*>(powers + player); //compare subtracts 1
+		_mm256_storeu_si256(coinsPtr, _mm256_sub_epi32(_mm256_loadu_si256(coinsPtr), _mm256_cmpeq_epi32(prize, one)));
+		_mm256_storeu_si256(powersPtr, _mm256_sub_epi32(_mm256_loadu_si256(powersPtr), _mm256_cmpeq_epi32(prize, two)));
+
+		//AVX2 cannot scatter, so the few prizes collected are marked one lane at a time
+		int collectLanes = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_andnot_si256(isFinish, hasPrize)));
+		if (collectLanes)
+		{
+			int laneNodes[VECTOR_PLAYERS];
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(laneNodes), nextNode);
+			for (; collectLanes; collectLanes &= collectLanes - 1) //Lowest lane first
+			{
+				int lane = __builtin_ctz(collectLanes);
+				collect(player + lane, laneNodes[lane]);
+			}
+		}
+
+		__m256i isBlocked = _mm256_andnot_si256(hasMoved, isValid);
+		__m256i isDeadEnd = _mm256_and_si256(isBlocked, _mm256_cmpgt_epi32(pathIndex, zero));
+		__m256i* livesPtr = reinterpret_cast<__m256i*>(lives + player);
+		__m256i livesLeft = _mm256_loadu_si256(livesPtr);
+		livesLeft = _mm256_add_epi32(livesLeft, _mm256_and_si256(isDeadEnd, _mm256_cmpgt_epi32(livesLeft, zero)));
+		_mm256_storeu_si256(livesPtr, livesLeft);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(nodeIds + player), _mm256_blendv_epi8(nodeId, nextNode, hasMoved));
+
+		if (outcomes)
+		{
+			__m256i outcome = _mm256_set1_epi32(MOVE_INVALID);
+			outcome = _mm256_blendv_epi8(outcome, _mm256_set1_epi32(MOVE_AT_START), isBlocked);
+			outcome = _mm256_blendv_epi8(outcome, _mm256_blendv_epi8(_mm256_set1_epi32(MOVE_DEAD_END),
+				_mm256_set1_epi32(MOVE_GAME_OVER), _mm256_cmpeq_epi32(livesLeft, zero)), isDeadEnd);
+			outcome = _mm256_blendv_epi8(outcome, _mm256_blendv_epi8(_mm256_set1_epi32(MOVE_SUCCESSFUL),
+				_mm256_set1_epi32(MOVE_FINISH), isFinish), hasMoved);
+
+			int laneOutcomes[VECTOR_PLAYERS];
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(laneOutcomes), outcome);
+			for (int lane = 0; lane < VECTOR_PLAYERS; ++lane)
+				outcomes[player + lane] = static_cast<MoveOutcome>(laneOutcomes[lane]);
+		}
+	}
+
+	return player;
+}
+
+bool BatchSimulator::hasAvx2()
+{
+	return __builtin_cpu_supports("avx2");
+}
+
+#else
+
+int BatchSimulator::stepVectorized(int firstPlayer, int lastPlayer, const int* pathIndices, MoveOutcome* outcomes)
+{
+	return firstPlayer; //Never called, since hasAvx2 is false
+}
+
+bool BatchSimulator::hasAvx2()
+{
+	return false;
+}
+
+#endif
+
+void BatchSimulator::collect(int player, int nodeId)
+{
+	collectedBits[static_cast<size_t>(player) * wordsPerPlayer + (nodeId >> 5)] |= uint32_t(1) << (nodeId & 31);
+	if (numCollected[player] < COLLECTED_LOG_SIZE)
+		collectedLog[static_cast<size_t>(player) * COLLECTED_LOG_SIZE + numCollected[player]] = nodeId;
+	numCollected[player]++;
+}
+
+void BatchSimulator::startOver(int player)
+{
+	nodeIds[player] = startId;
+	lives[player] = DEFAULT_LIVES;
+	coins[player] = 0;
+	powers[player] = 0;
+
+	uint32_t* row = collectedBits + static_cast<size_t>(player) * wordsPerPlayer;
+	if (numCollected[player] <= COLLECTED_LOG_SIZE) //Every bit that is set was logged
+	{
+		const int* log = collectedLog + static_cast<size_t>(player) * COLLECTED_LOG_SIZE;
+		for (int i = 0; i < numCollected[player]; ++i)
+			row[log[i] >> 5] = 0; //The other bits of the word are either logged too or already 0
+	}
+	else
+	{
+		for (int i = 0; i < wordsPerPlayer; ++i)
+			row[i] = 0;
+	}
+	numCollected[player] = 0;
+}
+
+void BatchSimulator::startOverAll()
+{
+	for (int player = 0; player < numPlayers; ++player)
+		startOver(player);
+}
+
+bool BatchSimulator::isValid() const
+{
+	return startId >= 0;
+}
+
+int BatchSimulator::getNumPlayers() const
+{
+	return numPlayers;
+}
+
+int BatchSimulator::getNodeId(int player) const
+{
+	return nodeIds[player];
+}
+
+int BatchSimulator::getLives(int player) const
+{
+	return lives[player];
+}
+
+int BatchSimulator::getCoins(int player) const
+{
+	return coins[player];
+}
+
+int BatchSimulator::getPowers(int player) const
+{
+	return powers[player];
+}
+
+int BatchSimulator::calcScore(int player) const
+{
+	return MULTIPLIERS[0] * lives[player] + MULTIPLIERS[1] * coins[player] + MULTIPLIERS[2] * powers[player];
+}
+
+bool BatchSimulator::isVectorized() const
+{
+	return vectorized;
+}
+
+void BatchSimulator::setVectorized(bool vectorized)
+{
+	this->vectorized = vectorized && hasAvx2();
+}
@@ -0,0 +1,105 @@
+#ifndef _BATCH_SIMULATOR_H
+#define _BATCH_SIMULATOR_H
+
+/*
+This is the class that moves many simulated players through the same maze in lockstep, for balancing
+runs where thousands of agents play at once. Every call to step makes one move for each of the players,
+following the same rules as movePlayer: a dead end costs a life, a prize is collected once per game,
+and the prize of the maze exit is given every time it is reached.
+
+The maze is read once, when the simulator is built, into flat tables indexed by node ID (see
+MazeInterface::writeNodeTables), so the maze can be changed or destroyed afterwards. The players are
+stored as a structure of arrays: one array each for their location, lives, coins and powers, and a
+bitset per player of the prizes they collected, which costs one bit per node and player. The first
+COLLECTED_LOG_SIZE prizes a player collects in a game are also logged, so that starting over only
+clears their bits, unless the player collected more, in which case their whole bitset is cleared.
+
+On processors with AVX2, step moves eight players at a time: the next nodes, the prizes and the
+collected bits of the eight players are each read with one gather, and the rules are applied with
+vector compares and blends. Other processors, and the players left over, use the same rules one
+player at a time.
+*/
+
+#include "MazeInterface.h"
+
+#include <stdint.h>
+
+const int COLLECTED_LOG_SIZE = 32; //Prizes logged per player and game, see above
+
+class BatchSimulator
+{
+public:
+	/*
+	@param maze: The maze the players move through.
+	numPlayers: The number of players, which all start at the start of the maze with the default
+	collectibles, as with setPlayer.
+	@post: If the maze cannot be written into tables (see MazeInterface::writeNodeTables), the simulator
+	is not valid and has no players.
+	*/
+	BatchSimulator(const MazeInterface& maze, int numPlayers);
+	~BatchSimulator();
+
+	/*
+	Makes one move for every player, as makeMove does.
+	@param: pathIndices - The path index taken by each player.
+	outcomes - NULL, or a buffer of getNumPlayers() outcomes, set to the outcome of each move.
+	*/
+	void step(const int* pathIndices, MoveOutcome* outcomes = NULL);
+
+	/*
+	Starts the game of player over, as startOver does, or the games of all of the players.
+	@post: The player is at the start with the default collectibles, and every prize can be collected again.
+	*/
+	void startOver(int player);
+	void startOverAll();
+
+	bool isValid() const; //Returns false if the maze was rejected, see the constructor
+	int getNumPlayers() const;
+	int getNodeId(int player) const; //Returns the ID of the location of player
+	int getLives(int player) const;
+	int getCoins(int player) const;
+	int getPowers(int player) const;
+	int calcScore(int player) const; //Returns the score of player, as calcScore does
+
+	/*
+	Returns true if step moves eight players at a time with AVX2. It does whenever the processor has
+	AVX2, unless setVectorized(false) was called, e.g. to compare against the other way.
+	*/
+	bool isVectorized() const;
+	void setVectorized(bool vectorized);
+
+	static bool hasAvx2(); //Returns true if the processor has AVX2
+
+private:
+	int numPaths; //Paths out of each node, see MazeInterface::getNumPaths
+	int numNodeIds; //Number of node IDs of the maze
+	int startId; //ID of the start
+	int* nextNodes; //numNodeIds * numPaths node IDs, -1 for a dead end, see MazeInterface::writeNodeTables
+	int* nodeInfo; //Prize code of each node, plus NODE_TABLE_FINISH for the maze exit
+
+	int numPlayers;
+	int* nodeIds; //The state of the players, one entry per player in each array
+	int* lives;
+	int* coins;
+	int* powers;
+	uint32_t* collectedBits; //Bit i of word i / 32 of the row of a player is set once they collected the prize of node i
+	int wordsPerPlayer; //Number of words of the row of each player in collectedBits
+	int* collectedLog; //COLLECTED_LOG_SIZE node IDs per player, the first prizes they collected in the game
+	int* numCollected; //Number of prizes each player collected in the game, only the first ones being logged
+	bool vectorized;
+
+	/*
+	Moves the players from firstPlayer to lastPlayer - 1, one at a time or eight at a time.
+	stepVectorized leaves out the last players if they are not a multiple of eight.
+	@return: The first player that was not moved.
+	*/
+	int stepScalar(int firstPlayer, int lastPlayer, const int* pathIndices, MoveOutcome* outcomes);
+	int stepVectorized(int firstPlayer, int lastPlayer, const int* pathIndices, MoveOutcome* outcomes);
+
+	void collect(int player, int nodeId); //Marks the prize of nodeId as collected by player
+
+	BatchSimulator(const BatchSimulator&); //The simulator owns its arrays, so it cannot be copied
+	BatchSimulator& operator=(const BatchSimulator&);
+};
+
+#endif
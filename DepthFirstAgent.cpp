@@ -0,0 +1,147 @@
+/*
+This is the implementation file corresponding to DepthFirstAgent.h containing the definitions of the member functions.
+*/
+
+#include "DepthFirstAgent.h"
+
+#include <cstddef>
+
+const int DEFAULT_AGENT_CAPACITY = 64; //Number of intersections the trie has room for at first
+
+DepthFirstAgent::DepthFirstAgent()
+	: numPaths(1), currentNode(0), nextNode(NULL), exitDirection(NULL), explored(NULL), numNodes(0), capacity(0)
+{
+	newMaze(1);
+}
+
+DepthFirstAgent::~DepthFirstAgent()
+{
+	delete [] nextNode;
+	delete [] exitDirection;
+	delete [] explored;
+}
+
+void DepthFirstAgent::newMaze(int numPaths)
+{
+	this->numPaths = (numPaths < MAX_AGENT_PATHS ? numPaths : MAX_AGENT_PATHS);
+	numNodes = 0; //Forget the previous maze, but keep the arrays
+	addNode(); //The start
+	startGame();
+}
+
+void DepthFirstAgent::startGame()
+{
+	while (pathTaken.pop());
+	currentNode = 0;
+}
+
+int DepthFirstAgent::addNode()
+{
+	if (numNodes == capacity) //Out of room, so we double the arrays
+	{
+		int newCapacity = (capacity ? 2*capacity : DEFAULT_AGENT_CAPACITY);
+		int* newNext = new int[newCapacity * MAX_AGENT_PATHS];
+		signed char* newExit = new signed char[newCapacity];
+		bool* newExplored = new bool[newCapacity];
+
+		for (int i = 0; i < numNodes * MAX_AGENT_PATHS; ++i)
+			newNext[i] = nextNode[i];
+		for (int i = 0; i < numNodes; ++i)
+		{
+			newExit[i] = exitDirection[i];
+			newExplored[i] = explored[i];
+		}
+
+		delete [] nextNode;
+		delete [] exitDirection;
+		delete [] explored;
+		nextNode = newNext;
+		exitDirection = newExit;
+		explored = newExplored;
+		capacity = newCapacity;
+	}
+
+	for (int i = 0; i < MAX_AGENT_PATHS; ++i)
+		nextNode[numNodes * MAX_AGENT_PATHS + i] = UNKNOWN_PATH;
+	exitDirection[numNodes] = -1;
+	explored[numNodes] = false;
+
+	return numNodes++;
+}
+
+int DepthFirstAgent::chooseMove()
+{
+	if (exitDirection[currentNode] >= 0) //We know the way out
+		return exitDirection[currentNode];
+
+	for (int i = 1; i < numPaths; ++i) //Otherwise the first direction that may still lead to the exit
+	{
+		int next = nextNode[currentNode * MAX_AGENT_PATHS + i];
+		if (next == UNKNOWN_PATH || (next >= 0 && !explored[next]))
+			return i;
+	}
+
+	explored[currentNode] = true; //Nothing left to try from here, so we go back
+	return 0;
+}
+
+void DepthFirstAgent::moveResult(int pathIndex, MoveOutcome outcome)
+{
+	if (pathIndex <= 0 || pathIndex >= numPaths) //Going backwards
+	{
+		if (outcome == MOVE_SUCCESSFUL && !pathTaken.empty())
+		{
+			currentNode = pathTaken.top();
+			pathTaken.pop();
+		}
+		return;
+	}
+
+	int& next = nextNode[currentNode * MAX_AGENT_PATHS + pathIndex];
+	switch (outcome)
+	{
+		case MOVE_SUCCESSFUL: //Moved forward, into an intersection we may not have seen yet
+			if (next < 0)
+			{
+				int newNode = addNode(); //addNode can move the arrays, so next is set afterwards
+				nextNode[currentNode * MAX_AGENT_PATHS + pathIndex] = newNode;
+			}
+			pathTaken.push(currentNode);
+			currentNode = nextNode[currentNode * MAX_AGENT_PATHS + pathIndex];
+			break;
+		case MOVE_DEAD_END:
+		case MOVE_GAME_OVER:
+			next = DEAD_END_PATH;
+			break;
+		case MOVE_FINISH:
+			recordExit(pathIndex);
+			break;
+		default: //Nothing happened
+			break;
+	}
+}
+
+void DepthFirstAgent::recordExit(int pathIndex)
+{
+	exitDirection[currentNode] = pathIndex;
+
+	Stack<int> pathCopy(pathTaken); //Walk back to the start, marking the way to the current intersection
+	int childNode = currentNode;
+	while (!pathCopy.empty())
+	{
+		int parentNode = pathCopy.top();
+		pathCopy.pop();
+
+		for (int i = 1; i < numPaths; ++i)
+		{
+			if (nextNode[parentNode * MAX_AGENT_PATHS + i] == childNode)
+				exitDirection[parentNode] = i;
+		}
+		childNode = parentNode;
+	}
+}
+
+int DepthFirstAgent::getNumKnownNodes() const
+{
+	return numNodes;
+}
@@ -0,0 +1,63 @@
+#ifndef _DEPTH_FIRST_AGENT_H
+#define _DEPTH_FIRST_AGENT_H
+
+/*
+Agent that searches the maze depth first and remembers what it found for as long as it plays the same
+maze. Within a single game it explores like WallFollowerAgent, but across games it never tries a known
+dead end or an explored part of the maze again, and once it has found the exit it walks straight to it.
+
+Since the mazes are trees, an intersection is identified by the directions taken from the start to reach
+it. The agent stores the intersections it has seen in a trie indexed by those directions, where the
+entry of each direction is either unknown, a dead end, or the index of the next intersection.
+*/
+
+#include "MazeAgent.h"
+#include "Stack.h"
+
+const int MAX_AGENT_PATHS = 8; //Largest number of directions of a maze the agent can play
+const int UNKNOWN_PATH = -1; //The direction has not been tried yet
+const int DEAD_END_PATH = -2; //The direction is a dead end
+
+class DepthFirstAgent : public MazeAgent
+{
+public:
+	DepthFirstAgent();
+	~DepthFirstAgent();
+
+	void newMaze(int numPaths); //Described in MazeAgent
+	void startGame(); //Described in MazeAgent
+	int chooseMove(); //Described in MazeAgent
+	void moveResult(int pathIndex, MoveOutcome outcome); //Described in MazeAgent
+
+	int getNumKnownNodes() const; //Returns the number of intersections the agent has seen in this maze
+
+private:
+	int numPaths; //Number of directions of the maze
+	int currentNode; //Trie index of the player's intersection
+
+	//The trie, one entry per intersection seen. The start is entry 0.
+	int* nextNode; //MAX_AGENT_PATHS entries per intersection, UNKNOWN_PATH, DEAD_END_PATH or a trie index
+	signed char* exitDirection; //Direction leading to the exit from each intersection, -1 if not known
+	bool* explored; //True once every direction out of the intersection has been tried without finding the exit
+	int numNodes; //Number of intersections in the trie
+	int capacity; //Number of intersections that fit into the arrays
+
+	Stack<int> pathTaken; //Trie indices of the intersections between the start and the current one
+
+	/*
+	Adds an intersection to the trie, with all of its directions unknown.
+	@return: The trie index of the new intersection.
+	*/
+	int addNode();
+
+	/*
+	Marks the exit as reached by taking pathIndex from the current intersection, so that every
+	intersection between the start and the current one leads to it.
+	*/
+	void recordExit(int pathIndex);
+
+	DepthFirstAgent(const DepthFirstAgent&); //The agent owns its trie, so it cannot be copied
+	DepthFirstAgent& operator=(const DepthFirstAgent&);
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef _FIXED_MAZE_NODE_CPP //This avoids compilation issues with template classes
+#define _FIXED_MAZE_NODE_CPP
+
+/*
+This is the implementation file corresponding to FixedMazeNode.h containing the definitions of the member
+functions.
+*/
+
+#include "FixedMazeNode.h"
+
+template <class ItemType, int NUM_PATHS, class LinkPolicy>
+FixedMazeNode<ItemType, NUM_PATHS, LinkPolicy>::FixedMazeNode(int prizeCode, bool isFinish)
+	: finish(isFinish), prizeNum(prizeCode)
+{
+	for (int i = 0; i < NUM_PATHS; ++i) //Set the default value of pathPtr[i] to NULL.
+		pathPtr[i] = LinkPolicy::getNullLink();
+}
+
+template <class ItemType, int NUM_PATHS, class LinkPolicy>
+FixedMazeNode<ItemType, NUM_PATHS, LinkPolicy>::FixedMazeNode(const FixedMazeNode& otherNode)
+	: finish(otherNode.finish), prizeNum(otherNode.prizeNum)
+{
+	for (int i = 0; i < NUM_PATHS; ++i) //We only want the node's contents, not its children.
+		pathPtr[i] = LinkPolicy::getNullLink();
+}
+
+template <class ItemType, int NUM_PATHS, class LinkPolicy>
+int FixedMazeNode<ItemType, NUM_PATHS, LinkPolicy>::getPrizeNum() const
+{
+	return prizeNum;
+}
+
+template <class ItemType, int NUM_PATHS, class LinkPolicy>
+bool FixedMazeNode<ItemType, NUM_PATHS, LinkPolicy>::isFinish() const
+{
+	return finish;
+}
+
+template <class ItemType, int NUM_PATHS, class LinkPolicy>
+int FixedMazeNode<ItemType, NUM_PATHS, LinkPolicy>::getNumPaths() const
+{
+	return NUM_PATHS;
+}
+
+template <class ItemType, int NUM_PATHS, class LinkPolicy>
+ItemType FixedMazeNode<ItemType, NUM_PATHS, LinkPolicy>::getNextNodePtr(int pathIndex) const
+{
+	if (0 <= pathIndex && pathIndex < NUM_PATHS) //Check if pathIndex is within the bounds
+		return pathPtr[pathIndex];
+	else //Return NULL if it isn't.
+		return LinkPolicy::getNullLink();
+}
+
+template <class ItemType, int NUM_PATHS, class LinkPolicy>
+void FixedMazeNode<ItemType, NUM_PATHS, LinkPolicy>::resetPrize()
+{
+	prizeNum = -prizeNum;
+}
+
+template <class ItemType, int NUM_PATHS, class LinkPolicy>
+bool FixedMazeNode<ItemType, NUM_PATHS, LinkPolicy>::setNextNodePtr(int pathIndex, ItemType nextNode)
+{
+	bool canSet = (0 <= pathIndex && pathIndex < NUM_PATHS); //Checking array bounds
+
+	if (canSet) //Setting the value of pathPtr[pathIndex] to nextNode if canSet is true
+		pathPtr[pathIndex] = nextNode;
+
+	return canSet;
+}
+
+template <class ItemType, int NUM_PATHS, class LinkPolicy>
+const FixedMazeNode<ItemType, NUM_PATHS, LinkPolicy>& FixedMazeNode<ItemType, NUM_PATHS, LinkPolicy>::operator=(
+							const FixedMazeNode<ItemType, NUM_PATHS, LinkPolicy>& other)
+{
+	if (this != &other) //We only want the values of finish and prizeNum.
+	{
+		finish = other.finish;
+		prizeNum = other.prizeNum;
+	}
+
+	return *this;
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef _FIXED_MAZE_NODE_H
+#define _FIXED_MAZE_NODE_H
+
+/*
+This is the class template that implements an intersection of the maze: its prize, whether it is the
+maze exit, and a link for each of the paths leading out of it. The number of paths is a template
+parameter, so the links are stored inline with the rest of the node rather than in a separately
+allocated array. Creating a node therefore costs a single allocation, and the node's links, prize and
+finish flag share the same block of memory. The prize and the finish flag only take a byte each, and sit
+next to each other at the start of the node.
+
+ItemType is intended to be a pointer data type. NUM_PATHS is the number of directions leading out of
+the node (3 for Level 1, 5 for Level 2). LinkPolicy gives the value of a dead end (see NodeLinks.h), so
+ItemType can also be a uint32_t index into a node table when LinkPolicy is IndexLinks.
+*/
+
+#include "NodeLinks.h"
+
+template <class ItemType, int NUM_PATHS, class LinkPolicy = PointerLinks<ItemType> > //ItemType is a pointer,
+class FixedMazeNode								//or an index with IndexLinks
+{
+public:
+	FixedMazeNode(int prizeCode = 0, bool isFinish = 0); //Default constructor
+	FixedMazeNode(const FixedMazeNode&); //Copy constructor
+
+	/*
+	Returns the prize number of the node. Note that 0 means no prize, 1 means that the node
+	contains a coin, while 2 means that the node has a power.
+	*/
+	int getPrizeNum() const;
+
+	/*
+	Returns the value of finish, used to check if the node is the finish node or maze exit.
+	*/
+	bool isFinish() const;
+
+	/*
+	Returns the number of paths of the node, i.e. NUM_PATHS.
+	*/
+	int getNumPaths() const;
+
+	/*
+	Returns the pointer to the next node at pathIndex if pathIndex is within the array bounds,
+	NULL otherwise (LinkPolicy::getNullLink() in general).
+	*/
+	ItemType getNextNodePtr(int pathIndex) const;
+
+	/*
+	Resets the value of prizeNum to -prizeNum in order to avoid repeat triggering of the node's
+	prize anytime the player moves backwards in the maze.
+	@post: The value of prizeNum is set to -prizeNum.
+	*/
+	void resetPrize();
+
+	/*
+	Sets the value of pathPtr[pathIndex] to nextNode if pathIndex is within the array bounds.
+	@return: True if pathIndex is within the array bounds, false otherwise.
+	*/
+	bool setNextNodePtr(int pathIndex, ItemType nextNode);
+
+	/*
+	Overriding the assignment operator. ONLY the values of finish and prizeNum are copied, the links
+	of the node are left untouched.
+	*/
+	const FixedMazeNode& operator=(const FixedMazeNode&);
+
+protected:
+	bool finish; //Variable to indicate if the node is the maze exit
+private:
+	signed char prizeNum; //Prize number of the node. 0 = no prize, 1 = coin, 2 = power
+	ItemType pathPtr[NUM_PATHS]; //The node's children/adjacent nodes, stored inline
+};
+
+#include "FixedMazeNode.cpp"
+
+#endif
@@ -0,0 +1,525 @@
+/*
+This is the implementation file corresponding to LazyMaze.h containing the definitions of the member functions.
+*/
+
+#include "LazyMaze.h"
+#include "MazeLevelOne.h"
+#include "MazeLevelTwo.h"
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <utility>
+
+//Names of the directions of each level, in the order of their path indices
+const char* const LEVEL_ONE_DIRECTION_NAMES[LEVEL_ONE_NUM_DIRECTIONS] = {"backwards", "left", "right"};
+const char* const LEVEL_TWO_DIRECTION_NAMES[LEVEL_TWO_NUM_DIRECTIONS] = {"backwards", "straight", "left", "right", "diagonal"};
+
+LazyMaze::LazyMaze(int level, long long numNodes) : LazyMaze(level, numNodes, MazeRandom::makeSeed())
+{
+}
+
+LazyMaze::LazyMaze(int level, long long numNodes, uint64_t seed)
+	: level(level == 1 ? 1 : 2), numPaths(level == 1 ? LEVEL_ONE_NUM_DIRECTIONS : LEVEL_TWO_NUM_DIRECTIONS),
+		numNodes(numNodes >= 2 ? numNodes : 2), seed(seed), finishDirections(NULL), finishDepth(0),
+		numChunks(0), nodeCount(0)
+{
+	findFinish();
+
+	LazyNode& start = getNode(addNode()); //No other thread can see the maze yet, so nothing is locked
+	start.key = seed;
+	start.budget = this->numNodes;
+	start.parentId = -1;
+	start.depth = start.branchDepth = 0;
+	start.prize = 0; //The start holds no prize, as in the levels
+	start.onFinishPath = true;
+	expand(0); //The players start on it
+	stats.finishGeneration(); //Started along with the maze
+}
+
+LazyMaze::~LazyMaze()
+{
+	for (int i = 0; i < numChunks; ++i)
+		delete [] chunks[i];
+	delete [] finishDirections;
+}
+
+LazyMaze::LazyNode& LazyMaze::getNode(int nodeId) const
+{
+	//Chunk c starts at ID LAZY_MAZE_FIRST_CHUNK_NODES * (2^c - 1), so c is the highest bit of this
+	uint32_t chunkNumber = uint32_t(nodeId) / LAZY_MAZE_FIRST_CHUNK_NODES + 1;
+	int chunk = 31 - __builtin_clz(chunkNumber);
+	return chunks[chunk][nodeId - LAZY_MAZE_FIRST_CHUNK_NODES * ((1 << chunk) - 1)];
+}
+
+int LazyMaze::addNode() const
+{
+	if (nodeCount == INT_MAX) //Every ID is taken
+		return -1;
+
+	long long chunkStart = LAZY_MAZE_FIRST_CHUNK_NODES * ((1LL << numChunks) - 1); //First ID past the last chunk
+	if (nodeCount == chunkStart) //The last chunk is full, so we allocate one twice as large
+	{
+		long long chunkSize = LAZY_MAZE_FIRST_CHUNK_NODES * (1LL << numChunks);
+		if (chunkSize > INT_MAX - chunkStart) //Only the IDs below INT_MAX are ever used
+			chunkSize = INT_MAX - chunkStart;
+		chunks[numChunks] = new LazyNode[chunkSize];
+		numChunks++;
+	}
+
+	int nodeId = nodeCount++;
+	getNode(nodeId).expanded.store(false, std::memory_order_relaxed);
+	return nodeId;
+}
+
+uint64_t LazyMaze::getChildKey(uint64_t key, int pathIndex)
+{
+	return key * 0x9E3779B97F4A7C15ULL + pathIndex; //MazeRandom mixes the key further when it is seeded
+}
+
+int LazyMaze::drawPrize(MazeRandom& random) const
+{
+	int distSize = (level == 1 ? LEVEL_ONE_PRIZE_DIST_SIZE : LEVEL_TWO_PRIZE_DIST_SIZE);
+	int coinMax = (level == 1 ? LEVEL_ONE_COIN_MAX : LEVEL_TWO_COIN_MAX);
+	int prizeCode = random.nextInt(distSize);
+
+	if (prizeCode <= coinMax)
+		return 1;
+	else if (prizeCode == coinMax + 1)
+		return 2;
+	else //No prize
+		return 0;
+}
+
+void LazyMaze::drawShape(uint64_t key, long long budget, LazyShape& shape) const
+{
+	MazeRandom random(key);
+	shape.prize = drawPrize(random); //Drawn first, so that a child's prize can be drawn without its shape
+	shape.numChildren = 0;
+	if (budget <= 1) //Nothing left for children
+		return;
+
+	int numForward = numPaths - 1;
+	shape.numChildren = 1 + random.nextInt(budget - 1 < numForward ? int(budget - 1) : numForward);
+
+	//Distinct random directions, with a partial Fisher-Yates shuffle as in MazeLevelTwo::connectChildren
+	int pathArray[LAZY_MAZE_MAX_DIRECTIONS - 1] = {1, 2, 3, 4};
+	for (int i = 0; i < shape.numChildren; ++i)
+	{
+		int swapIndex = i + random.nextInt(numForward - i);
+		std::swap(pathArray[i], pathArray[swapIndex]);
+		shape.directions[i] = pathArray[i];
+	}
+
+	//Every child gets one node, and the rest of the budget is cut at numChildren - 1 random points. The
+	//cuts are drawn with a modulo, whose bias is negligible next to 2^64.
+	long long extra = budget - 1 - shape.numChildren;
+	long long cuts[LAZY_MAZE_MAX_DIRECTIONS - 1];
+	for (int i = 0; i < shape.numChildren - 1; ++i)
+	{
+		cuts[i] = random.next() % (uint64_t(extra) + 1);
+		for (int j = i; j > 0 && cuts[j - 1] > cuts[j]; --j) //At most three cuts to sort
+			std::swap(cuts[j - 1], cuts[j]);
+	}
+	cuts[shape.numChildren - 1] = extra;
+
+	long long previousCut = 0;
+	for (int i = 0; i < shape.numChildren; ++i)
+	{
+		shape.budgets[i] = cuts[i] - previousCut + 1;
+		previousCut = cuts[i];
+	}
+}
+
+void LazyMaze::findFinish()
+{
+	int capacity = 64;
+	finishDirections = new signed char[capacity];
+
+	uint64_t key = seed;
+	long long budget = numNodes;
+	LazyShape shape;
+	drawShape(key, budget, shape);
+	while (shape.numChildren > 0)
+	{
+		int largest = 0;
+		for (int i = 1; i < shape.numChildren; ++i)
+		{
+			if (shape.budgets[i] > shape.budgets[largest])
+				largest = i;
+		}
+
+		if (finishDepth == capacity) //Out of room, so we double the array
+		{
+			signed char* newDirections = new signed char[2 * capacity];
+			for (int i = 0; i < finishDepth; ++i)
+				newDirections[i] = finishDirections[i];
+			delete [] finishDirections;
+			finishDirections = newDirections;
+			capacity *= 2;
+		}
+		finishDirections[finishDepth++] = shape.directions[largest];
+
+		key = getChildKey(key, shape.directions[largest]);
+		budget = shape.budgets[largest];
+		drawShape(key, budget, shape);
+	}
+}
+
+LazyMaze::LazyNode& LazyMaze::expand(int nodeId) const
+{
+	LazyNode& node = getNode(nodeId);
+	if (node.expanded.load(std::memory_order_acquire)) //Pairs with the release below, so the children are visible
+		return node;
+
+	std::lock_guard<std::mutex> lock(expandMutex);
+	if (!node.expanded.load(std::memory_order_relaxed)) //Another thread may have expanded it while we waited
+	{
+		LazyShape shape;
+		drawShape(node.key, node.budget, shape);
+		for (int pathIndex = 1; pathIndex < numPaths; ++pathIndex)
+			node.children[pathIndex] = -1;
+
+		for (int i = 0; i < shape.numChildren; ++i)
+		{
+			int childId = addNode();
+			if (childId < 0) //The maze stopped growing, so the children left stay dead ends
+				break;
+
+			LazyNode& child = getNode(childId);
+			child.key = getChildKey(node.key, shape.directions[i]);
+			child.budget = shape.budgets[i];
+			child.parentId = nodeId;
+			child.depth = node.depth + 1;
+			child.onFinishPath = (node.onFinishPath && node.depth < finishDepth
+				&& finishDirections[node.depth] == shape.directions[i]);
+			child.branchDepth = (child.onFinishPath ? child.depth : node.branchDepth);
+
+			MazeRandom random(child.key);
+			child.prize = drawPrize(random);
+			node.children[shape.directions[i]] = childId;
+		}
+
+		node.expanded.store(true, std::memory_order_release);
+	}
+
+	return node;
+}
+
+int LazyMaze::getNextNode(const LazyNode& node, int pathIndex) const
+{
+	return (pathIndex == 0 ? node.parentId : node.children[pathIndex]);
+}
+
+void LazyMaze::setPlayer(Player* newPlayer)
+{
+	setPlayer(ownOverlay, newPlayer);
+}
+
+void LazyMaze::setPlayer(MazeOverlay& overlay, Player* newPlayer) const
+{
+	overlay.start(newPlayer, 0); //Put the new player at the start of the maze, with every prize in place
+	if (newPlayer && level == 1) //Level 1 also resets the collectibles of the player
+		newPlayer->resetNumItems();
+}
+
+int LazyMaze::movePlayer(int nextPathIndex)
+{
+	MazeStats::Timer timer(stats, STATS_MOVE_PLAYER);
+	MoveEvent event = makeMove(nextPathIndex);
+	const char* const* names = (level == 1 ? LEVEL_ONE_DIRECTION_NAMES : LEVEL_TWO_DIRECTION_NAMES);
+	return printMoveEvent(event, (event.outcome == MOVE_INVALID ? "" : names[nextPathIndex]), ownOverlay.getPlayer());
+}
+
+inline MoveEvent LazyMaze::stepPlayer(MazeOverlay& overlay, int& location, int nextPathIndex) const
+{
+	Player* playerPtr = overlay.getPlayer();
+	MoveEvent event = {MOVE_INVALID, 0, 0, -1};
+
+	if (0 <= nextPathIndex && nextPathIndex < numPaths)
+	{
+		int nextNode = getNextNode(getNode(location), nextPathIndex); //The player's location is always expanded
+		if (nextNode >= 0) //Valid movement
+		{
+			location = nextNode; //Move the player
+			const LazyNode& node = expand(location); //The player stands on it, so its children are needed now
+			event.prize = (overlay.isCollected(location) ? 0 : node.prize);
+			if (!isFinish(node)) //Player did not reach the finish
+			{
+				event.outcome = MOVE_SUCCESSFUL;
+				if (event.prize > 0) //Check if the player won a prize
+				{
+					playerPtr->incrementQuantity(event.prize); //Index 1 = coins, 2 = powers
+					overlay.collect(location);
+				}
+			}
+			else //Finish node is reached, and it may also contain a prize
+			{
+				event.outcome = MOVE_FINISH;
+				if (event.prize > 0)
+					playerPtr->incrementQuantity(event.prize);
+			}
+		}
+		else if (nextPathIndex > 0) //Dead end, > 0 accounts for the case where player moves
+					//backwards from the starting position
+		{
+			playerPtr->decrementQuantity(0); //Decrement the life
+			event.outcome = (playerPtr->getQuantity(0) == 0 ? MOVE_GAME_OVER : MOVE_DEAD_END);
+		}
+		else //Player tries to move backwards, but they are at the start so they can't
+			event.outcome = MOVE_AT_START;
+	}
+
+	event.livesLeft = playerPtr->getQuantity(0); //Also set for an invalid path index, the player exists
+	event.nodeId = location;
+
+	return event;
+}
+
+MoveEvent LazyMaze::makeMove(int nextPathIndex)
+{
+	return LazyMaze::makeMove(ownOverlay, nextPathIndex); //Qualified, so that the call is not virtual
+}
+
+MoveEvent LazyMaze::makeMove(MazeOverlay& overlay, int nextPathIndex) const
+{
+	stats.addCalls(STATS_MAKE_MOVE); //Counted but not timed, see MazeStats.h
+	MoveEvent event = {MOVE_INVALID, 0, 0, -1};
+	if (overlay.getPlayer()) //Move only if a player exists
+	{
+		int location = overlay.getLocation();
+		event = stepPlayer(overlay, location, nextPathIndex);
+		overlay.setLocation(location);
+	}
+
+	return event;
+}
+
+int LazyMaze::makeMoves(const int* pathIndices, int numMoves, MoveEvent* events)
+{
+	int movesMade = 0;
+	if (ownOverlay.getPlayer())
+	{
+		int location = ownOverlay.getLocation();
+		bool gameEnded = false;
+		while (movesMade < numMoves && !gameEnded)
+		{
+			events[movesMade] = stepPlayer(ownOverlay, location, pathIndices[movesMade]);
+			gameEnded = (events[movesMade].outcome == MOVE_FINISH || events[movesMade].outcome == MOVE_GAME_OVER);
+			movesMade++;
+		}
+		ownOverlay.setLocation(location);
+	}
+	stats.addCalls(STATS_MAKE_MOVE, movesMade); //Once for the whole batch
+
+	return movesMade;
+}
+
+const char** LazyMaze::getPossiblePaths() const //Return all the possible directions
+{
+	const char** optionPtr = new const char*[numPaths];
+	optionPtr[0] = "Go backwards.";
+	if (level == 1) //Same order as MazeLevelOne::getPossiblePaths
+	{
+		optionPtr[1] = "Go left.";
+		optionPtr[2] = "Go right.";
+	}
+	else //Same order as MazeLevelTwo::getPossiblePaths
+	{
+		optionPtr[1] = "Go straight.";
+		optionPtr[2] = "Go left.";
+		optionPtr[3] = "Go right.";
+		optionPtr[4] = "Go diagonal.";
+	}
+
+	return optionPtr;
+}
+
+int LazyMaze::getNumPaths() const
+{
+	return numPaths;
+}
+
+int LazyMaze::getNodeIdLimit() const
+{
+	std::lock_guard<std::mutex> lock(expandMutex);
+	return nodeCount;
+}
+
+int LazyMaze::writeNodeTables(int* nextNodes, int* nodeInfo) const
+{
+	std::lock_guard<std::mutex> lock(expandMutex);
+	if (nodeCount < numNodes) //Some intersections were not generated, so some children are not known
+		return -1;
+
+	for (int i = 0; i < nodeCount; ++i)
+	{
+		const LazyNode& node = getNode(i);
+		bool expanded = node.expanded.load(std::memory_order_relaxed); //Only changed under the lock, and an
+										//intersection not expanded has no children
+		for (int pathIndex = 0; pathIndex < numPaths; ++pathIndex)
+			nextNodes[i * numPaths + pathIndex] = (pathIndex == 0 || expanded ? getNextNode(node, pathIndex) : -1);
+		nodeInfo[i] = node.prize + (isFinish(node) ? NODE_TABLE_FINISH : 0);
+	}
+
+	return 0; //The start
+}
+
+bool LazyMaze::reveal() const
+{
+	MazeStats::Timer timer(stats, STATS_REVEAL);
+	int pathIndex = revealPath();
+	if (pathIndex >= 0) //if there is a player in the maze, and that player had at least one power to use
+	{
+		const char* const* names = (level == 1 ? LEVEL_ONE_DIRECTION_NAMES : LEVEL_TWO_DIRECTION_NAMES);
+		std::cout << "Consuming your power..." << std::endl;
+		std::cout << "Go " << names[pathIndex] << " to get to the maze exit!" << std::endl;
+		std::cout << "The exit is " << getDistanceToFinish() << " intersection(s) away." << std::endl;
+	}
+	else //No powers to consume
+		std::cout << "You have no power to use!" << std::endl;
+
+	return (pathIndex >= 0);
+}
+
+int LazyMaze::revealPath() const
+{
+	return revealPath(ownOverlay);
+}
+
+int LazyMaze::revealPath(const MazeOverlay& overlay) const
+{
+	stats.addCalls(STATS_REVEAL_PATH);
+	Player* playerPtr = overlay.getPlayer();
+	if (!playerPtr || !playerPtr->decrementQuantity(2)) //We can only reveal if there is a player in the maze,
+		return -1;					//and that player has at least one power to use
+
+	const LazyNode& node = getNode(overlay.getLocation());
+	if (node.onFinishPath && node.depth < finishDepth) //The next intersection on the path leads to the finish
+		return finishDirections[node.depth];
+	else //Off the path, or on the finish, so we go backwards
+		return 0;
+}
+
+int LazyMaze::getDistanceToFinish() const
+{
+	if (ownOverlay.getPlayer()) //Back to the path to the finish, then down it
+	{
+		const LazyNode& node = getNode(ownOverlay.getLocation());
+		return (node.depth - node.branchDepth) + (finishDepth - node.branchDepth);
+	}
+	else //Dummy value if there is no player
+		return -1;
+}
+
+int LazyMaze::calcScore() const
+{
+	Player* playerPtr = ownOverlay.getPlayer();
+	if (playerPtr) //Calculate the score only if a player exists in the maze
+	{
+		int score = 0;
+
+		for (int i = 0; i < NUM_COLLECTIBLES; ++i)
+			score += MULTIPLIERS[i] * (playerPtr->getQuantity(i));
+
+		return score;
+	}
+	else //Return dummy value if the condition is not met.
+		return -1;
+}
+
+void LazyMaze::startOver()
+{
+	startOver(ownOverlay);
+}
+
+void LazyMaze::startOver(MazeOverlay& overlay) const
+{
+	MazeStats::Timer timer(stats, STATS_START_OVER);
+	if (overlay.getPlayer())
+	{
+		overlay.setLocation(0);
+		overlay.getPlayer()->resetNumItems();
+	}
+	overlay.resetCollected(); //Puts back the prizes collected since the last reset
+}
+
+int LazyMaze::getLevel() const
+{
+	return level;
+}
+
+long long LazyMaze::getNumNodes() const
+{
+	return numNodes;
+}
+
+uint64_t LazyMaze::getSeed() const
+{
+	return seed;
+}
+
+size_t LazyMaze::getBytesUsed() const
+{
+	std::lock_guard<std::mutex> lock(expandMutex);
+	return ((size_t(1) << numChunks) - 1) * LAZY_MAZE_FIRST_CHUNK_NODES * sizeof(LazyNode) //The chunks
+		+ finishDepth * sizeof(signed char); //The path to the finish
+}
+
+void LazyMaze::readShape(MazeStatsReport& report) const
+{
+	report.level = level;
+	report.bytesUsed = getBytesUsed();
+	report.depth = finishDepth;
+
+	std::lock_guard<std::mutex> lock(expandMutex);
+	report.nodesAllocated = nodeCount;
+	report.deadEnds = report.coins = report.powers = 0;
+	for (int i = 0; i < nodeCount; ++i)
+	{
+		const LazyNode& node = getNode(i);
+		if (!isFinish(node) && node.expanded.load(std::memory_order_relaxed)) //The player stops at the finish
+		{
+			for (int pathIndex = 1; pathIndex < numPaths; ++pathIndex)
+				report.deadEnds += (node.children[pathIndex] < 0);
+		}
+
+		report.coins += (node.prize == 1);
+		report.powers += (node.prize == 2);
+	}
+}
+
+void LazyMaze::displayMaze() const //Display the maze one intersection at a time
+{
+	std::cout << (level == 1 ? "   L R" : "   S L R D") << std::endl;
+
+	std::lock_guard<std::mutex> lock(expandMutex);
+	for (int i = 0; i < nodeCount; ++i)
+	{
+		const LazyNode& node = getNode(i);
+		if (!isFinish(node))
+		{
+			std::cout << (ownOverlay.getLocation() == i ? "P  " : "O  ");
+			bool expanded = node.expanded.load(std::memory_order_relaxed);
+			for (int pathIndex = 1; pathIndex < numPaths; ++pathIndex)
+			{
+				int childId = (expanded ? node.children[pathIndex] : -1);
+				if (!expanded) //Not generated yet
+					std::cout << "? ";
+				else if (childId < 0) //Dead end
+					std::cout << "X ";
+				else if (isFinish(getNode(childId)))
+					std::cout << "F ";
+				else
+					std::cout << (ownOverlay.getLocation() == childId ? "P " : "O ");
+			}
+		}
+		else //The finish has no intersections beyond it
+		{
+			std::cout << "F ";
+			for (int pathIndex = 1; pathIndex < numPaths; ++pathIndex)
+				std::cout << " -";
+		}
+		std::cout << std::endl;
+	}
+}
@@ -0,0 +1,221 @@
+#ifndef _LAZY_MAZE_H
+#define _LAZY_MAZE_H
+
+/*
+This is the class implementing a maze that is generated while it is played, rather than all at once when
+it is built, so that its size only costs anything in the parts of it the players reach. It is derived from
+MazeInterface, and plays by the rules and with the directions of Level 1 or Level 2.
+
+Every intersection is given a number of nodes, its budget, for itself and for everything beyond it: the
+start is given the number of nodes of the maze, and an intersection splits what is left of its budget at
+random between its children, so the maze still has exactly that many nodes. Whatever is drawn for an
+intersection (its prize, its children, their directions and their budgets) is drawn from a generator
+seeded with its key, which is made from the seed of the maze and the directions taken from the start to
+reach it. An intersection is therefore always the same, whichever order the maze is explored in, and
+starting over or replaying a game finds the same maze.
+
+The children of an intersection are generated the first time a player stands on it, and are given the
+next free IDs, so the IDs (see makeMove) depend on the order the maze was explored in, but the maze does
+not. The maze exit is found when the maze is built, by following the child with the largest budget from
+the start until an intersection without children, which only generates the draws along that path, so
+building a maze takes the same time however many nodes it has. The intersections are stored in chunks
+that double in size, so the memory used grows with the number of intersections generated. At most
+INT_MAX of them are generated, as the IDs are ints, after which the maze stops growing (see addNode).
+
+Generating intersections changes the maze, which the functions taking an overlay otherwise never do. They
+are generated under a lock, and published with an atomic flag, so the maze can still be played by many
+overlays from different threads at once, and only the moves onto new intersections take the lock.
+*/
+
+#include "MazeInterface.h"
+#include "MazeRandom.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdint.h>
+
+const int LAZY_MAZE_MAX_DIRECTIONS = 5; //Directions of Level 2, the most of either level
+const int LAZY_MAZE_FIRST_CHUNK_NODES = 1024; //Intersections in the first chunk, each chunk holds twice as many as the last
+const int LAZY_MAZE_MAX_CHUNKS = 22; //Enough chunks for INT_MAX intersections, the last one cut short
+const long long DEFAULT_LAZY_MAZE_NODE_NUM = 1000000000; //A billion nodes
+
+class LazyMaze : public MazeInterface
+{
+public:
+	/*
+	Creates the maze, generating only the start and the path to the exit. The maze is generated from a
+	seed drawn from rand() (see MazeRandom::makeSeed).
+	@param level: 1 for the directions of Level 1, 2 (or anything else) for those of Level 2.
+	numNodes: The number of nodes of the maze, at least 2.
+	*/
+	LazyMaze(int level = 2, long long numNodes = DEFAULT_LAZY_MAZE_NODE_NUM);
+
+	//Same as above, but the maze is generated from seed, so the same arguments always give the same maze.
+	LazyMaze(int level, long long numNodes, uint64_t seed);
+	~LazyMaze(); //Destructor
+
+	void setPlayer(Player* newPlayer); //Described in maze interface
+	void setPlayer(MazeOverlay& overlay, Player* newPlayer) const; //Described in maze interface
+	int movePlayer(int nextPathIndex); //Described in maze interface
+
+	/*
+	Described in maze interface. The ID of a node is the order it was generated in, 0 being the start.
+	The children of the node the player reaches are generated if they were not yet.
+	*/
+	MoveEvent makeMove(int nextPathIndex);
+	MoveEvent makeMove(MazeOverlay& overlay, int nextPathIndex) const;
+	int makeMoves(const int* pathIndices, int numMoves, MoveEvent* events); //Described in maze interface
+
+	const char** getPossiblePaths() const; //Described in maze interface, the paths of the level of the maze
+	int getNumPaths() const; //Described in maze interface
+	int getNodeIdLimit() const; //Described in maze interface, the number of intersections generated so far
+
+	/*
+	Described in maze interface. The tables of a maze whose nodes were not all generated would not hold
+	the maze, so -1 is returned until every node was generated, e.g. by playing the maze through.
+	*/
+	int writeNodeTables(int* nextNodes, int* nodeInfo) const;
+
+	bool reveal() const; //Described in maze interface
+	int revealPath() const; //Described in maze interface
+	int revealPath(const MazeOverlay& overlay) const; //Described in maze interface
+	int calcScore() const; //Described in maze interface
+	void startOver(); //Described in maze interface
+	void startOver(MazeOverlay& overlay) const; //Described in maze interface
+
+	/*
+	Outputs the intersections generated so far as an adjacency list, in the style of MazeLevelTwo, with
+	one column per direction. The intersections whose children have not been generated yet show a
+	"?" in every column.
+	*/
+	void displayMaze() const;
+
+	int getLevel() const; //Returns the level whose rules and directions the maze plays by
+	long long getNumNodes() const; //Returns the number of nodes of the maze, generated or not
+	uint64_t getSeed() const; //Returns the seed the maze is generated from
+	size_t getBytesUsed() const; //Returns the number of bytes held by the chunks and the path to the exit
+
+	/*
+	Returns the number of intersections between the player and the maze exit, as
+	MazeLevelTwo::getDistanceToFinish does.
+	*/
+	int getDistanceToFinish() const;
+
+protected:
+	/*
+	Described in maze interface. Only the intersections generated so far are counted, and the depth is
+	the depth of the exit.
+	*/
+	void readShape(MazeStatsReport& report) const;
+
+private:
+	/*
+	An intersection that was generated. Its children are only valid once expanded is set.
+	*/
+	struct LazyNode
+	{
+		uint64_t key; //Seeds the generator drawing the intersection, see above
+		long long budget; //Number of nodes of the maze from this intersection on, itself included
+		int parentId; //ID of the parent, -1 for the start
+		int children[LAZY_MAZE_MAX_DIRECTIONS]; //ID of the child in each direction, -1 for a dead end. Entry 0
+							//is unused, backwards being parentId
+		int depth; //Number of intersections between the start and this one
+		int branchDepth; //Depth of the last intersection on the way here that is on the path to the exit
+		signed char prize; //Prize code, the games keep track of the ones they collected
+		bool onFinishPath; //True if the intersection is on the path from the start to the exit
+		std::atomic<bool> expanded; //Set once the children are generated
+	};
+
+	/*
+	What is drawn for an intersection from its key and budget.
+	*/
+	struct LazyShape
+	{
+		int prize; //Prize code
+		int numChildren;
+		int directions[LAZY_MAZE_MAX_DIRECTIONS - 1]; //Direction of each child
+		long long budgets[LAZY_MAZE_MAX_DIRECTIONS - 1]; //Budget of each child, at least 1
+	};
+
+	int level; //1 or 2
+	int numPaths; //Directions of the level, backwards included
+	long long numNodes; //Budget of the start
+	uint64_t seed; //Seed of the maze, which is also the key of the start
+	MazeOverlay ownOverlay; //Game played by the functions that take no overlay
+
+	signed char* finishDirections; //Direction taken from each intersection on the path to the exit, in order
+	int finishDepth; //Depth of the exit, the number of entries of finishDirections
+
+	mutable LazyNode* chunks[LAZY_MAZE_MAX_CHUNKS]; //Chunk c holds LAZY_MAZE_FIRST_CHUNK_NODES << c intersections
+	mutable int numChunks; //Number of chunks allocated
+	mutable int nodeCount; //Number of intersections generated
+	mutable std::mutex expandMutex; //Guards the generation of intersections, and the members above
+
+	/*
+	Returns the intersection having the given ID, which must have been generated. The chunk is found from
+	the highest bit of the ID, so this is a few instructions.
+	*/
+	LazyNode& getNode(int nodeId) const;
+
+	/*
+	Returns true if node is the maze exit.
+	*/
+	bool isFinish(const LazyNode& node) const { return node.onFinishPath && node.depth == finishDepth; }
+
+	/*
+	Draws what an intersection having key and budget holds.
+	@post: shape holds the prize, and the directions and budgets of the children, which are 0 if the
+	budget is 1.
+	*/
+	void drawShape(uint64_t key, long long budget, LazyShape& shape) const;
+
+	/*
+	Returns the key of the child of the intersection having key, in direction pathIndex.
+	*/
+	static uint64_t getChildKey(uint64_t key, int pathIndex);
+
+	/*
+	Returns the prize code drawn first by the generator of every intersection, with the same odds as the
+	prizes of the level.
+	*/
+	int drawPrize(MazeRandom& random) const;
+
+	/*
+	Follows the child with the largest budget from the start, the first one if several have it, until an
+	intersection without children, which is the maze exit.
+	@post: finishDirections and finishDepth hold the path to the exit.
+	*/
+	void findFinish();
+
+	/*
+	Generates the children of intersection nodeId if they were not yet, and returns it.
+	*/
+	LazyNode& expand(int nodeId) const;
+
+	/*
+	Adds a new intersection, allocating a chunk if the last one is full. Must be called with expandMutex
+	locked.
+	@return: The ID of the new intersection, whose members are uninitialized but for expanded, which is
+	false, or -1 if INT_MAX intersections were generated, as many as there are IDs. The maze then stops
+	growing: expand leaves the children it cannot add as dead ends.
+	*/
+	int addNode() const;
+
+	/*
+	Returns the ID of the intersection reached by taking pathIndex from node, or -1 if it is a dead end.
+	The node must be expanded.
+	*/
+	int getNextNode(const LazyNode& node, int pathIndex) const;
+
+	/*
+	Moves the player of overlay, who must exist, from location towards nextPathIndex, as the stepPlayer
+	of the levels do, and generates the children of the new location.
+	*/
+	MoveEvent stepPlayer(MazeOverlay& overlay, int& location, int nextPathIndex) const;
+
+	LazyMaze(const LazyMaze&); //The maze changes as it is played, so it is not copied
+	LazyMaze& operator=(const LazyMaze&);
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef _MAZE_AGENT_H
+#define _MAZE_AGENT_H
+
+/*
+This is the interface for the strategies that play the maze on their own, used by SimulationEngine
+to run games without a terminal. An agent only knows what a player would know: the number of directions
+the maze has, and what happened after each of its moves. It is never shown the maze itself.
+
+The directions are the path indices of the maze (see MazeInterface::movePlayer), so 0 is always
+backwards, and the outcome of a move is the one returned by MazeInterface::makeMove.
+*/
+
+#include "MazeInterface.h"
+
+class MazeAgent
+{
+public:
+	virtual ~MazeAgent() {}; //Virtual destructor for the derived agents
+
+	/*
+	Called when the agent is put into a maze it has not played before. The agent forgets anything
+	it learned about the previous maze.
+	@param numPaths: The number of directions of the maze, see MazeInterface::getNumPaths.
+	*/
+	virtual void newMaze(int numPaths) = 0;
+
+	/*
+	Called when the player is put back at the start of the maze for a new game.
+	*/
+	virtual void startGame() = 0;
+
+	/*
+	Returns the direction the agent wants to take next.
+	*/
+	virtual int chooseMove() = 0;
+
+	/*
+	Tells the agent what happened after it moved towards pathIndex.
+	*/
+	virtual void moveResult(int pathIndex, MoveOutcome outcome) = 0;
+};
+
+#endif
@@ -0,0 +1,176 @@
+/*
+This is the implementation file corresponding to MazeFactory.h containing the definitions of the member functions.
+*/
+
+#include "MazeFactory.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+/*
+Lowers the priority of the calling thread to the lowest there is, so that it only runs when nothing
+else wants to.
+*/
+static void lowerThreadPriority()
+{
+#ifdef SCHED_IDLE //Linux only, the threads keep the default priority elsewhere
+	sched_param parameters;
+	parameters.sched_priority = 0;
+	pthread_setschedparam(pthread_self(), SCHED_IDLE, &parameters);
+#endif
+}
+
+MazeFactory::MazeFactory(int levelOneNodes, int levelTwoNodes, int poolSize, int numWorkers, bool balancedLevelOne)
+	: balancedLevelOne(balancedLevelOne), poolSize(poolSize), seedRandom(MazeRandom::makeSeed()), stopping(false),
+		numWorkers(numWorkers > 0 ? numWorkers : 0), workers(NULL)
+{
+	numNodes[0] = levelOneNodes;
+	numNodes[1] = levelTwoNodes;
+	for (int i = 0; i < NUM_MAZE_LEVELS; ++i)
+		numBuilding[i] = 0;
+
+	//The threads are started last, once everything they use is set up
+	if (this->numWorkers > 0)
+	{
+		workers = new std::thread[this->numWorkers];
+		for (int i = 0; i < this->numWorkers; ++i)
+			workers[i] = std::thread(&MazeFactory::runWorker, this);
+	}
+	reclaimer = std::thread(&MazeFactory::runReclaimer, this);
+}
+
+MazeFactory::~MazeFactory()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	workersWakeUp.notify_all();
+	reclaimerWakeUp.notify_all();
+
+	for (int i = 0; i < numWorkers; ++i)
+		workers[i].join();
+	delete [] workers;
+	reclaimer.join(); //Deletes the reclaimed mazes before it stops
+
+	for (int i = 0; i < NUM_MAZE_LEVELS; ++i) //No thread is left, so the pools are ours
+	{
+		while (!readyMazes[i].empty())
+		{
+			delete readyMazes[i].front();
+			readyMazes[i].pop();
+		}
+	}
+}
+
+MazeInterface* MazeFactory::takeMaze(int level)
+{
+	if (level < 1 || level > NUM_MAZE_LEVELS)
+		return NULL;
+
+	MazeInterface* mazePtr = NULL;
+	uint64_t seed = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!readyMazes[level - 1].empty())
+		{
+			mazePtr = readyMazes[level - 1].front();
+			readyMazes[level - 1].pop();
+		}
+		else //Nothing ready, so we will have to build it ourselves
+			seed = seedRandom.next();
+	}
+	workersWakeUp.notify_one(); //The pool has room for another maze
+
+	if (!mazePtr)
+		mazePtr = buildMaze(level, seed);
+
+	return mazePtr;
+}
+
+void MazeFactory::reclaim(MazeInterface* mazePtr)
+{
+	if (mazePtr)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			reclaimedMazes.push(mazePtr);
+		}
+		reclaimerWakeUp.notify_one();
+	}
+}
+
+int MazeFactory::getNumReady(int level) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return (1 <= level && level <= NUM_MAZE_LEVELS ? readyMazes[level - 1].size() : 0);
+}
+
+MazeInterface* MazeFactory::buildMaze(int level, uint64_t seed) const
+{
+	if (level == 1)
+		return new MazeLevelOne(numNodes[0], balancedLevelOne, seed);
+	else
+		return new MazeLevelTwo(numNodes[1], seed);
+}
+
+int MazeFactory::findLevelToBuild() const
+{
+	int level = 0;
+	int fewestMazes = poolSize; //Pools with poolSize mazes, ready or being built, are full
+	for (int i = 0; i < NUM_MAZE_LEVELS; ++i)
+	{
+		int numMazes = readyMazes[i].size() + numBuilding[i];
+		if (numMazes < fewestMazes)
+		{
+			level = i + 1;
+			fewestMazes = numMazes;
+		}
+	}
+
+	return level;
+}
+
+void MazeFactory::runWorker()
+{
+	lowerThreadPriority();
+	std::unique_lock<std::mutex> lock(mutex);
+	while (!stopping)
+	{
+		int level = findLevelToBuild();
+		if (level == 0) //Every pool is full, so we wait for a maze to be taken
+			workersWakeUp.wait(lock);
+		else
+		{
+			uint64_t seed = seedRandom.next();
+			numBuilding[level - 1]++;
+
+			lock.unlock(); //Other threads can take mazes while we build this one
+			MazeInterface* mazePtr = buildMaze(level, seed);
+			lock.lock();
+
+			numBuilding[level - 1]--;
+			readyMazes[level - 1].push(mazePtr);
+		}
+	}
+}
+
+void MazeFactory::runReclaimer()
+{
+	lowerThreadPriority();
+	std::unique_lock<std::mutex> lock(mutex);
+	while (!stopping || !reclaimedMazes.empty())
+	{
+		if (reclaimedMazes.empty())
+			reclaimerWakeUp.wait(lock);
+		else
+		{
+			MazeInterface* mazePtr = reclaimedMazes.front();
+			reclaimedMazes.pop();
+
+			lock.unlock(); //Other threads can reclaim mazes while we delete this one
+			delete mazePtr;
+			lock.lock();
+		}
+	}
+}
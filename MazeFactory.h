@@ -0,0 +1,112 @@
+#ifndef _MAZE_FACTORY_H
+#define _MAZE_FACTORY_H
+
+/*
+This is the class that hands out new mazes for "Try a new maze" without making the player wait for them.
+It keeps a small pool of ready-built mazes for each level, which worker threads refill in the background
+whenever a maze is taken. Mazes that are no longer needed are given back with reclaim, and a reclaimer
+thread deletes them, so the player does not wait for the old maze to be torn down either. Taking a maze
+from a non-empty pool and reclaiming one are constant time, however large the mazes are.
+
+Each maze is generated from its own seed (see MazeRandom), so the workers never share a generator. The
+seeds are drawn from a generator owned by the factory, which is seeded from rand() when the factory is
+created, so srand must be called before that for the mazes to differ from one run to the next.
+*/
+
+#include "MazeInterface.h"
+#include "MazeLevelOne.h"
+#include "MazeLevelTwo.h"
+#include "MazeRandom.h"
+#include "Queue.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+const int NUM_MAZE_LEVELS = 2; //Level 1 and Level 2
+const int DEFAULT_MAZE_POOL_SIZE = 2; //Mazes kept ready for each level
+const int DEFAULT_MAZE_FACTORY_WORKERS = 2; //Threads building the mazes
+
+class MazeFactory
+{
+public:
+	/*
+	Creates the factory and starts its threads, which begin filling the pools right away.
+	@param levelOneNodes, levelTwoNodes: The number of nodes of the mazes of each level.
+	poolSize: The number of mazes kept ready for each level.
+	numWorkers: The number of threads building mazes. With 0, every maze is built by takeMaze.
+	balancedLevelOne: If true, the Level 1 mazes are built balanced (see MazeLevelOne), which large
+	Level 1 mazes need to be built in reasonable time.
+	*/
+	MazeFactory(int levelOneNodes = DEFAULT_LEVEL_ONE_NODE_NUM, int levelTwoNodes = DEFAULT_LEVEL_TWO_NODE_NUM,
+			int poolSize = DEFAULT_MAZE_POOL_SIZE, int numWorkers = DEFAULT_MAZE_FACTORY_WORKERS,
+			bool balancedLevelOne = false);
+
+	/*
+	Stops the threads once the mazes they are working on are done, deletes the mazes that were
+	reclaimed but not deleted yet, and deletes the mazes left in the pools.
+	*/
+	~MazeFactory();
+
+	/*
+	Returns a new maze of the given level, which the caller owns and should give back with reclaim.
+	A maze is taken from the pool if one is ready, and the workers are told to build a replacement.
+	If the pool is empty, the maze is built on the calling thread instead.
+	@param level: 1 for Level 1, 2 for Level 2.
+	@return: The new maze, or NULL if level is neither 1 nor 2.
+	*/
+	MazeInterface* takeMaze(int level);
+
+	/*
+	Gives a maze back to the factory, which deletes it on the reclaimer thread. The maze must not be
+	used afterwards. NULL is ignored.
+	*/
+	void reclaim(MazeInterface* mazePtr);
+
+	/*
+	Returns the number of mazes of the given level that are ready to be taken.
+	*/
+	int getNumReady(int level) const;
+
+private:
+	int numNodes[NUM_MAZE_LEVELS]; //Number of nodes of the mazes of each level
+	bool balancedLevelOne; //True if the Level 1 mazes are balanced
+	int poolSize; //Number of mazes kept ready for each level
+	Queue<MazeInterface*> readyMazes[NUM_MAZE_LEVELS]; //The pools of ready-built mazes
+	int numBuilding[NUM_MAZE_LEVELS]; //Number of mazes of each level being built by the workers
+	Queue<MazeInterface*> reclaimedMazes; //Mazes waiting to be deleted by the reclaimer
+	MazeRandom seedRandom; //Draws the seed of every maze
+	bool stopping; //Set by the destructor to stop the threads
+
+	mutable std::mutex mutex; //Guards all of the members above
+	std::condition_variable workersWakeUp; //Notified when a pool has room, or when the factory stops
+	std::condition_variable reclaimerWakeUp; //Notified when a maze is reclaimed, or when the factory stops
+
+	int numWorkers; //Number of threads in workers
+	std::thread* workers; //Threads refilling the pools
+	std::thread reclaimer; //Thread deleting the reclaimed mazes
+
+	/*
+	Builds a maze of the given level from seed, on the calling thread.
+	*/
+	MazeInterface* buildMaze(int level, uint64_t seed) const;
+
+	/*
+	Returns the level whose pool is the furthest from full, counting the mazes being built, or 0 if
+	every pool is full. Must be called with mutex locked.
+	*/
+	int findLevelToBuild() const;
+
+	/*
+	The loops run by the worker threads and by the reclaimer thread, until the factory stops. Both first
+	lower the priority of their thread, so that on a machine with few cores they only run when the
+	player's thread has nothing to do, instead of delaying it right after a maze is taken or reclaimed.
+	*/
+	void runWorker();
+	void runReclaimer();
+
+	MazeFactory(const MazeFactory&); //The factory owns its threads, so it cannot be copied
+	MazeFactory& operator=(const MazeFactory&);
+};
+
+#endif
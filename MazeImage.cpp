@@ -0,0 +1,177 @@
+/*
+This is the implementation file corresponding to MazeImage.h containing the definitions of the member functions.
+*/
+
+#include "MazeImage.h"
+
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MazeImage::MazeImage()
+	: mapping(NULL), mappingSize(0), file(NULL), currentSection(-1), fileSize(0), writeFailed(false)
+{
+	memset(&header, 0, sizeof(header));
+}
+
+MazeImage::~MazeImage()
+{
+	unmap();
+	if (file)
+		fclose(file);
+}
+
+bool MazeImage::create(const char* fileName, uint32_t level, uint32_t nodeSize, uint32_t nodeCount,
+			uint32_t startId, uint32_t finishId, uint64_t seed)
+{
+	if (file) //Abandon the image that was being written
+		fclose(file);
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, MAZE_IMAGE_MAGIC, sizeof(header.magic));
+	header.version = MAZE_IMAGE_VERSION;
+	header.byteOrder = MAZE_IMAGE_BYTE_ORDER;
+	header.level = level;
+	header.nodeSize = nodeSize;
+	header.nodeCount = nodeCount;
+	header.startId = startId;
+	header.finishId = finishId;
+	header.seed = seed;
+
+	file = fopen(fileName, "wb");
+	currentSection = -1;
+	fileSize = sizeof(header);
+	writeFailed = !file || fwrite(&header, sizeof(header), 1, file) != 1; //Rewritten by finish, once the
+										//sections are known
+	return !writeFailed;
+}
+
+bool MazeImage::writeSection(int section, const void* data, size_t size)
+{
+	if (!file || section < currentSection || section >= MAZE_IMAGE_MAX_SECTIONS)
+		return false;
+
+	if (section != currentSection) //Start the section on the next aligned offset
+	{
+		static const char padding[MAZE_IMAGE_ALIGNMENT] = {0};
+		size_t paddingSize = (MAZE_IMAGE_ALIGNMENT - fileSize % MAZE_IMAGE_ALIGNMENT) % MAZE_IMAGE_ALIGNMENT;
+		if (paddingSize > 0 && fwrite(padding, 1, paddingSize, file) != paddingSize)
+			writeFailed = true;
+
+		fileSize += paddingSize;
+		currentSection = section;
+		header.sectionOffsets[section] = fileSize;
+	}
+
+	if (size > 0 && fwrite(data, 1, size, file) != size)
+		writeFailed = true;
+
+	fileSize += size;
+	header.sectionSizes[section] += size;
+
+	return !writeFailed;
+}
+
+void MazeImage::setFinishId(uint32_t finishId)
+{
+	if (file) //The header is only written by finish
+		header.finishId = finishId;
+}
+
+bool MazeImage::finish()
+{
+	if (!file)
+		return false;
+
+	if (fseeko(file, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, file) != 1) //Now with the sections
+		writeFailed = true;
+	if (fclose(file) != 0)
+		writeFailed = true;
+	file = NULL;
+
+	return !writeFailed;
+}
+
+bool MazeImage::map(const char* fileName, uint32_t level)
+{
+	int fileDescriptor = open(fileName, O_RDONLY);
+	if (fileDescriptor < 0)
+		return false;
+
+	struct stat fileStatus;
+	char* newMapping = NULL;
+	size_t newSize = 0;
+	if (fstat(fileDescriptor, &fileStatus) == 0 && size_t(fileStatus.st_size) >= sizeof(MazeImageHeader))
+	{
+		newSize = fileStatus.st_size;
+		void* address = mmap(NULL, newSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		newMapping = (address == MAP_FAILED ? NULL : static_cast<char*>(address));
+	}
+	close(fileDescriptor); //The mapping keeps the file open
+
+	if (!newMapping)
+		return false;
+
+	const MazeImageHeader* newHeader = reinterpret_cast<const MazeImageHeader*>(newMapping);
+	bool isValid = (memcmp(newHeader->magic, MAZE_IMAGE_MAGIC, sizeof(newHeader->magic)) == 0
+		&& newHeader->version == MAZE_IMAGE_VERSION && newHeader->byteOrder == MAZE_IMAGE_BYTE_ORDER
+		&& newHeader->level == level);
+
+	for (int i = 0; i < MAZE_IMAGE_MAX_SECTIONS && isValid; ++i) //Every section has to be inside the file
+	{
+		isValid = (newHeader->sectionOffsets[i] % MAZE_IMAGE_ALIGNMENT == 0
+			&& newHeader->sectionOffsets[i] <= newSize
+			&& newHeader->sectionSizes[i] <= newSize - newHeader->sectionOffsets[i]);
+	}
+
+	if (!isValid)
+	{
+		munmap(newMapping, newSize);
+		return false;
+	}
+
+	unmap();
+	mapping = newMapping;
+	mappingSize = newSize;
+	memcpy(&header, newHeader, sizeof(header));
+
+	return true;
+}
+
+void MazeImage::unmap()
+{
+	if (mapping)
+		munmap(mapping, mappingSize);
+
+	mapping = NULL;
+	mappingSize = 0;
+}
+
+bool MazeImage::isMapped() const
+{
+	return (mapping != NULL);
+}
+
+const MazeImageHeader& MazeImage::getHeader() const
+{
+	return header;
+}
+
+char* MazeImage::getSection(int section, uint64_t size) const
+{
+	if (!mapping || section < 0 || section >= MAZE_IMAGE_MAX_SECTIONS || header.sectionSizes[section] != size)
+		return NULL;
+
+	return mapping + header.sectionOffsets[section];
+}
+
+void MazeImage::swap(MazeImage& otherImage)
+{
+	std::swap(header, otherImage.header);
+	std::swap(mapping, otherImage.mapping);
+	std::swap(mappingSize, otherImage.mappingSize);
+}
@@ -0,0 +1,128 @@
+#ifndef _MAZE_IMAGE_H
+#define _MAZE_IMAGE_H
+
+/*
+This is the class that reads and writes maze images, the binary files that curated mazes are stored in.
+An image is a header followed by a few sections, each of which is an array of fixed-width fields. Nodes
+refer to each other by their index, never by address, so the image is position independent. An image
+holds the nodes or arrays of the maze exactly as they are in memory (see MazeNodeOne for Level 1), so
+loading it is a matter of mapping the file into memory with mmap, checking the maze, and pointing the
+maze at the sections, with no allocation per node.
+
+The file is mapped read only, and a maze can still be played straight from the mapping: the prizes a
+game collects are kept in its MazeOverlay, so a loaded maze never writes to its nodes.
+
+File layout (all fields in the byte order of the machine that wrote it, see MAZE_IMAGE_BYTE_ORDER):
+
+	MazeImageHeader
+	section 0, starting at header.sectionOffsets[0], header.sectionSizes[0] bytes long
+	section 1, ...
+
+Every section starts at a multiple of MAZE_IMAGE_ALIGNMENT bytes, and the unused sections have a size of 0.
+What the sections hold depends on the level, see MazeLevelOne::save and MazeLevelTwo::save.
+*/
+
+#include <cstddef>
+#include <cstdio>
+#include <stdint.h>
+
+const char MAZE_IMAGE_MAGIC[8] = "MAZEIMG"; //First bytes of every image
+const uint32_t MAZE_IMAGE_VERSION = 3; //Incremented whenever the layout of the images changes
+const uint32_t MAZE_IMAGE_BYTE_ORDER = 0x01020304; //Reads differently on a machine of the other byte order
+const int MAZE_IMAGE_MAX_SECTIONS = 8; //Number of sections an image can have
+const int MAZE_IMAGE_ALIGNMENT = 64; //Sections start on a cache line
+
+struct MazeImageHeader
+{
+	char magic[8]; //MAZE_IMAGE_MAGIC
+	uint32_t version; //MAZE_IMAGE_VERSION
+	uint32_t byteOrder; //MAZE_IMAGE_BYTE_ORDER
+	uint32_t level; //1 or 2, the level the maze belongs to
+	uint32_t nodeSize; //Size of one node record in bytes, for the levels that store them, 0 otherwise
+	uint32_t nodeCount; //Number of nodes (or node slots) in the maze
+	uint32_t startId; //Index of the start of the maze
+	uint32_t finishId; //Index of the maze exit
+	uint32_t reserved; //Always 0
+	uint64_t seed; //Seed the maze was generated from
+	uint64_t sectionOffsets[MAZE_IMAGE_MAX_SECTIONS]; //Offset of each section from the start of the file
+	uint64_t sectionSizes[MAZE_IMAGE_MAX_SECTIONS]; //Size of each section in bytes
+};
+
+class MazeImage
+{
+public:
+	MazeImage();
+	~MazeImage(); //Unmaps the image, and abandons an image that was being written without calling finish
+
+	/*
+	Starts writing an image into fileName, replacing the file if it exists.
+	@param: level, nodeSize, nodeCount, startId, finishId, seed - The fields of the header, see MazeImageHeader.
+	@return: True if the file could be created, false otherwise.
+	*/
+	bool create(const char* fileName, uint32_t level, uint32_t nodeSize, uint32_t nodeCount, uint32_t startId,
+			uint32_t finishId, uint64_t seed);
+
+	/*
+	Appends size bytes of data to a section of the image being written. The sections have to be written
+	in order, but a section can be written in several pieces by calling this repeatedly with the same
+	section number.
+	@return: True if the data was written, false otherwise.
+	*/
+	bool writeSection(int section, const void* data, size_t size);
+
+	/*
+	Changes the index of the maze exit in the header of the image being written, for the levels that
+	only know it once their nodes are written. Does nothing if no image is being written.
+	*/
+	void setFinishId(uint32_t finishId);
+
+	/*
+	Writes the header and closes the image being written.
+	@return: True if every write of the image succeeded, false otherwise.
+	*/
+	bool finish();
+
+	/*
+	Maps the image stored in fileName into memory, after checking that its header is one of a maze of the
+	given level written by this version of the program on a machine of the same byte order.
+	@post: If the image was mapped, the image that was mapped before is unmapped. Otherwise nothing changes.
+	@return: True if the image was mapped, false otherwise.
+	*/
+	bool map(const char* fileName, uint32_t level);
+
+	/*
+	Unmaps the image. Any pointer returned by getSection becomes invalid.
+	*/
+	void unmap();
+
+	bool isMapped() const; //Returns true if an image is mapped
+	const MazeImageHeader& getHeader() const; //Returns the header of the mapped image
+
+	/*
+	Returns a pointer to a section of the mapped image. The memory is read only: writing to it crashes
+	the program.
+	@param size: The size the section is expected to have.
+	@return: The section, or NULL if its size is not size bytes.
+	*/
+	char* getSection(int section, uint64_t size) const;
+
+	/*
+	Exchanges the mapped images of the two objects, so that an image can be mapped and checked before it
+	replaces the one in use.
+	*/
+	void swap(MazeImage& otherImage);
+
+private:
+	MazeImageHeader header; //Header of the mapped image, or of the image being written
+	char* mapping; //Start of the mapped file, NULL if no image is mapped
+	size_t mappingSize; //Size of the mapped file
+	FILE* file; //Image being written, NULL if there is none
+	int currentSection; //Section being written, -1 before the first one
+	uint64_t fileSize; //Number of bytes written to file so far
+	bool writeFailed; //True if one of the writes to file failed
+
+	MazeImage(const MazeImage&); //The image owns its mapping, so it cannot be copied
+	MazeImage& operator=(const MazeImage&);
+};
+
+#endif
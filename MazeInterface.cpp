@@ -0,0 +1,67 @@
+/*
+This is the implementation file corresponding to MazeInterface.h, containing the messages shared by
+the movePlayer functions of both levels, and the statistics shared by both levels.
+*/
+
+#include "MazeInterface.h"
+
+#include <iostream>
+
+int MazeInterface::printMoveEvent(const MoveEvent& event, const char* directionName, const Player* playerPtr) const
+{
+	int moveResult = 0;
+	switch (event.outcome)
+	{
+		case MOVE_SUCCESSFUL:
+			switch (event.prize) //Check if the player won a prize
+			{
+				case 1: //Player won a coin
+					std::cout << "Congratulations! You've received a coin!" << std::endl;
+					std::cout << "You have " << playerPtr->getQuantity(1)
+						<< " coins." << std::endl;
+					break;
+				case 2: //Player won a power
+					std::cout << "CONGRATULATIONS!! You've received a power!" << std::endl;
+					std::cout << "Activate it to reveal the next location that";
+					std::cout << " will lead you to the finish line!" << std::endl;
+					std::cout << "You have " << playerPtr->getQuantity(2)
+						<< " powers to use." << std::endl;
+					break;
+			}
+			std::cout << "Successfully moved " << directionName << "." << std::endl; //Tell the player the move was successful
+			break;
+		case MOVE_FINISH:
+			std::cout << "CONGRATULATIONS!!! You've successfully reached the finish line!" << std::endl;
+			if (event.prize > 0) //Check if the finish node also contains a prize
+			{
+				std::cout << "AND you're lucky! You've just stumbled upon an extra ";
+				std::cout << (event.prize == 1 ? "coin!" : "power!") << std::endl;
+			}
+			moveResult = -1;
+			break;
+		case MOVE_DEAD_END: //We tell the player how many lives they have left.
+			std::cout << "You've hit a dead end and lost a life!" << std::endl;
+			std::cout << "You have " << event.livesLeft << " lives left, ";
+			std::cout << "and are still at the same intersection." << std::endl;
+			break;
+		case MOVE_GAME_OVER:
+			std::cout << "You've hit a dead end and lost a life!" << std::endl;
+			moveResult = -2;
+			break;
+		case MOVE_AT_START:
+			std::cout << "Cannot move backwards since you are already at the start!" << std::endl;
+			break;
+		default: //Nothing happened, so there is nothing to say
+			break;
+	}
+
+	return moveResult;
+}
+
+MazeStatsReport MazeInterface::getStats() const
+{
+	MazeStatsReport report;
+	readShape(report);
+	stats.read(report);
+	return report;
+}
@@ -5,15 +5,48 @@
 This is the interface for any maze object, Level 1 or Level 2. It is an ADT containing all of the
 necessary functions required. It also houses the multipliers for each power-up available in the maze, used in
 calculating the score
+
+A maze is only changed by building or loading it. The game played in it, i.e. the player, their location
+and the prizes they collected, is kept in a MazeOverlay, so one maze can be shared by many games: the
+functions taking an overlay play that game, and the others play the overlay owned by the maze.
 */
 
 
+#include "MazeOverlay.h"
+#include "MazeStats.h"
 #include "Player.h"
 
 //Used to calculate the score. Note that a life is worth 500 points, a coin is 100,
 //and a power is 1000.
 const int MULTIPLIERS[NUM_COLLECTIBLES] = {500, 100, 1000};
 
+/*
+What happened when the player tried to move, see makeMove.
+*/
+enum MoveOutcome : unsigned char
+{
+	MOVE_SUCCESSFUL, //The player moved to the next intersection
+	MOVE_DEAD_END, //The player hit a dead end, lost a life and stayed at the same intersection
+	MOVE_FINISH, //The player reached the maze exit
+	MOVE_GAME_OVER, //The player hit a dead end and ran out of lives
+	MOVE_AT_START, //The player tried to go backwards from the start, and stayed there
+	MOVE_INVALID //There is no player, or the path index is out of bounds, so nothing happened
+};
+
+/*
+Everything that happened during a move, returned by makeMove. It is small enough to be returned in a
+register, so a move does no I/O and no allocation.
+*/
+struct MoveEvent
+{
+	MoveOutcome outcome;
+	signed char prize; //Prize picked up at the new location: 0 = none, 1 = a coin, 2 = a power
+	short livesLeft; //Lives of the player after the move, 0 if there is no player
+	int nodeId; //ID of the player's location after the move (see the levels), -1 if there is no player
+};
+
+const int NODE_TABLE_FINISH = 4; //Added to the prize code of the maze exit in the tables of writeNodeTables
+
 class MazeInterface
 {
 public:
@@ -21,14 +54,21 @@ public:
 					//for Levels 1 and 2 of the maze.
 
 	/*
-	Sets a new player into the maze, and resets the nodes and the player collectibles
-	to accommodate the change. Also removes the existing player.
+	Sets a new player into the maze, and puts back the prizes collected and resets the player
+	collectibles to accommodate the change. Also removes the existing player.
 	@param newPlayer: pointer to the player object
-	@post: The player of the maze is set to newPlayer, all of the nodes of the maze are reset,
+	@post: The player of the maze is set to newPlayer, every prize of the maze can be collected again,
 	and the number of collectibles of the player is set to the default values.
 	*/
 	virtual void setPlayer(Player* newPlayer) = 0;
 
+	/*
+	Same as above, but starts the game of overlay instead of the game owned by the maze. The maze is not
+	changed, so this can be called on a maze shared by many overlays, from any thread, as long as each
+	overlay is only used by one thread at a time. The overlay must then only be played in this maze.
+	*/
+	virtual void setPlayer(MazeOverlay& overlay, Player* newPlayer) const = 0;
+
 
 	/*
 	Moves the player to the next direction in the maze, if nextPathIndex is within the array bounds
@@ -54,6 +94,27 @@ public:
 	*/
 	virtual int movePlayer(int nextPathIndex) = 0;
 
+	/*
+	Makes the same move as movePlayer, but prints nothing. What happened is returned instead, and it is
+	up to the caller to tell the player about it. movePlayer is this function followed by printMoveEvent.
+	@param: nextPathIndex : index of pathPtr for the intersection node.
+	@post: Same as movePlayer.
+	@return: The outcome of the move, the prize collected, the lives left and the player's new location.
+	*/
+	virtual MoveEvent makeMove(int nextPathIndex) = 0;
+	virtual MoveEvent makeMove(MazeOverlay& overlay, int nextPathIndex) const = 0; //Plays overlay, see setPlayer
+
+	/*
+	Makes the moves in pathIndices one after the other with makeMove, in a single call. Stops early once
+	the player reaches the maze exit or runs out of lives, so the last move made ends the game.
+	@param: pathIndices - The numMoves path indices to take, in order.
+	numMoves - The number of moves to make.
+	events - Buffer of at least numMoves events, filled with the result of every move made.
+	@post: The same as calling makeMove for each of the moves made.
+	@return: The number of moves made, 0 if there is no player.
+	*/
+	virtual int makeMoves(const int* pathIndices, int numMoves, MoveEvent* events) = 0;
+
 	/*
 	Returns the possible paths the player can take in the maze for the client.
 	This is level dependent, so see the corresponding derived classes for more information.
@@ -68,12 +129,39 @@ public:
 	*/
 	virtual int getNumPaths() const = 0;
 
+	/*
+	Returns the number of node IDs of the maze: the IDs of the nodes, see makeMove, are between 0 and
+	this number - 1. Some IDs may belong to no node, e.g. in Level 1 once nodes were removed.
+	*/
+	virtual int getNodeIdLimit() const = 0;
+
+	/*
+	Writes the maze into flat tables indexed by node ID, e.g. for BatchSimulator. The IDs that belong
+	to no node are dead ends in every direction, with no prize.
+	@param: nextNodes - Buffer of getNodeIdLimit() * getNumPaths() IDs. Entry id * getNumPaths() + pathIndex
+	is set to the ID of the node reached by taking pathIndex from node id, or to -1 for a dead end.
+	nodeInfo - Buffer of getNodeIdLimit() entries. Each is set to the prize code of the node, plus
+	NODE_TABLE_FINISH if it is the maze exit.
+	@return: The ID of the start, or -1 if the maze cannot be written into tables, e.g. a LazyMaze whose
+	nodes were not all generated, in which case the buffers are left untouched.
+	*/
+	virtual int writeNodeTables(int* nextNodes, int* nodeInfo) const = 0;
+
 	/*
 	Outputs the next direction the player must take to reach the finish, if they have a power.
 	Decrements their power afterwards.
 	*/
 	virtual bool reveal() const = 0;
 
+	/*
+	Uses one of the player's powers like reveal, but prints nothing. reveal is this function followed
+	by the messages.
+	@return: The index of the path leading to the finish, or -1 if there is no player or they have
+	no power to use.
+	*/
+	virtual int revealPath() const = 0;
+	virtual int revealPath(const MazeOverlay& overlay) const = 0; //Plays overlay, see setPlayer
+
 	/*
 	Calculates the player's total score for the maze. Note that a life is worth 500 points,
 	a coin 100, and a power 1000.
@@ -83,13 +171,15 @@ public:
 	/*
 	If a player exists in the maze, then the player is moved back to the start, and their
 	collectibles are reset to their default values.
-	Finally, the nodes of the maze are also reset.
+	Finally, the prizes the game collected are put back.
 
 	@post: The player collectibles are at their default values, and the player is moved back
-	to the start IF a player exists. Otherwise, nothing happens. Finally, all nodes of the maze
-	are reset to their default values.
+	to the start IF a player exists. Otherwise, nothing happens. Finally, the overlay of the game
+	has no prize collected (see MazeOverlay::resetCollected), so every prize can be collected
+	again. The maze itself is not changed.
 	*/
 	virtual void startOver() = 0;
+	virtual void startOver(MazeOverlay& overlay) const = 0; //Plays overlay, see setPlayer
 
 	/*
 	Displays the entire maze, including the location of the player, the finish and all dead ends.
@@ -98,6 +188,35 @@ public:
 	for details on how this is done.
 	*/
 	virtual void displayMaze() const = 0;
+
+	/*
+	Returns the statistics of the maze: its size and shape, the time it took to generate, and the calls
+	made so far to movePlayer, reveal and startOver along with the time they took (see MazeStats). Only
+	the calls playing the maze's own game are counted, not those taking an overlay or makeMove and
+	revealPath, which movePlayer and reveal call.
+	The calls are counted on every thread, but the shape is counted by walking the maze, in O(n), so
+	this must not be called while another thread is moving the player.
+	*/
+	MazeStatsReport getStats() const;
+
+protected:
+	mutable MazeStats stats; //Counts the calls, which are made from const functions such as reveal and makeMove
+
+	/*
+	Fills in the members of report describing the maze itself: the level, the numbers of nodes, bytes,
+	dead ends and prizes, and the depth. Used by getStats.
+	*/
+	virtual void readShape(MazeStatsReport& report) const = 0;
+
+	/*
+	Prints the messages of movePlayer for a move that was made with makeMove.
+	@param: event - What happened during the move
+	directionName - Name of the direction that was taken, e.g. "left"
+	playerPtr - The player that moved, whose collectibles are shown
+	@return: The value movePlayer returns for the move: -1 if the player reached the maze exit,
+	-2 if they are out of lives, and 0 otherwise.
+	*/
+	int printMoveEvent(const MoveEvent& event, const char* directionName, const Player* playerPtr) const;
 };
 
 #endif
@@ -4,49 +4,85 @@ This is the implementation file corresponding to MazeLevelOne.h, where the defin
 
 #include "MazeLevelOne.h"
 #include "Queue.h"
+#include "Stack.h"
 
 #include <cstdlib>
+#include <climits>
+#include <cstring>
 #include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <new>
+#include <utility>
 
-MazeLevelOne::MazeLevelOne(int numNodes)
-	: playerPtr(NULL), playerLoc(NULL), startPtr(new MazeNodeOne(0, LEVEL_ONE_NUM_DIRECTIONS, 0,
-							rand() % KEY_DIST_SIZE))
+const char* const DIRECTION_NAMES[LEVEL_ONE_NUM_DIRECTIONS] = {"backwards", "left", "right"}; //Used by movePlayer
+
+MazeLevelOne::MazeLevelOne(int numNodes, bool balanced) : MazeLevelOne(numNodes, balanced, MazeRandom::makeSeed())
 {
+}
+
+MazeLevelOne::MazeLevelOne(int numNodes, bool balanced, uint64_t seed)
+	: nodeArena(std::min(std::max(numNodes, DEFAULT_LEVEL_ONE_NODE_NUM), DEFAULT_ARENA_CHUNK_NODES)), random(seed),
+		startPtr(createNode(0, 0, random.nextInt(KEY_DIST_SIZE), INT_MAX)),
+		finishPtr(NULL)
+{ //The starting node has the largest priority so that it stays the root of a balanced maze
+
 	if (numNodes <= 2) //At least two nodes have to occur, we can't have the starting node
 		numNodes = DEFAULT_LEVEL_ONE_NODE_NUM; //also be the finish
 
-	buildMaze(--numNodes); //We decrement by 1 since we've already created the starting node
+	buildMaze(--numNodes, balanced); //We decrement by 1 since we've already created the starting node
+	markFinishPath(true); //Only mark the path once the shape of the tree is final
+	stats.finishGeneration(); //Started along with the maze
 }
 
 MazeLevelOne::MazeLevelOne(const MazeLevelOne& otherMaze)
+	: nodeArena(otherMaze.nodeArena.getNodesPerChunk()), random(otherMaze.random.getSeed())
 {
-	playerPtr = NULL; //We don't want the same player, only the same maze
-	playerLoc = NULL;
+	finishPtr = NULL; //Set by copyTree, along with the finish path marks which are part of the copy
 
-	startPtr = copyTree(startPtr, otherMaze.startPtr); //Copy the shape of the maze
+	startPtr = copyTree(otherMaze, otherMaze.startPtr); //Copy the shape of the maze
+	stats.finishGeneration(); //Counts the time taken by the copy, whose counters start at 0
 }
 
 MazeLevelOne::~MazeLevelOne()
+{ //The nodes are released all at once along with nodeArena's chunks
+}
+
+template <class... Args>
+MazeNodeOne* MazeLevelOne::createNode(Args&&... args)
+{
+	uint32_t index = nodeArena.createIndex(std::forward<Args>(args)...);
+	MazeNodeOne* nodePtr = nodeArena.getNode(index);
+	nodePtr->setNodeIndex(index); //So that the other nodes can link to it
+
+	return nodePtr;
+}
+
+MazeNodeOne* MazeLevelOne::getNextNode(const MazeNodeOne* nodePtr, int pathIndex) const
+{
+	uint32_t index = nodePtr->getNextNodePtr(pathIndex);
+	return (index == NULL_NODE_INDEX ? NULL : nodeArena.getNode(index));
+}
+
+void MazeLevelOne::setNextNode(MazeNodeOne* nodePtr, int pathIndex, MazeNodeOne* nextNode)
 {
-	postOrderDelete(startPtr);
+	nodePtr->setNextNodePtr(pathIndex, nextNode ? nextNode->getNodeIndex() : NULL_NODE_INDEX);
 }
 
-void MazeLevelOne::buildMaze(int numNodes)
+void MazeLevelOne::buildMaze(int numNodes, bool balanced)
 {
 	MazeNodeOne* newNodePtr = NULL;
 
 	do //The following loop inserts nodes into the maze until an amount equivalent to numNodes
 	{ //has been inserted.
-		int newKey = rand() % KEY_DIST_SIZE; //Randomly generate the sort key for the node
+		int newKey = random.nextInt(KEY_DIST_SIZE); //Randomly generate the sort key for the node
 		bool atEnd = (numNodes == 1); //Last node is the finish, so this will be 1 for that case
 
 
 		//The code section below generates the prize of the node
 		//Note that coints have a 1/3 chance of occuring, while a power
 		//occurs with a 1/n chance, where n is the prize distribution size.
-		int prizeCode = rand() % LEVEL_ONE_PRIZE_DIST_SIZE;
+		int prizeCode = random.nextInt(LEVEL_ONE_PRIZE_DIST_SIZE);
 		if (prizeCode <= LEVEL_ONE_COIN_MAX) //Node has a coin
 			prizeCode = 1;
 		else if (prizeCode == LEVEL_ONE_COIN_MAX + 1) //Node has a power
@@ -56,61 +92,117 @@ void MazeLevelOne::buildMaze(int numNodes)
 
 
 		//Create the new node, and insert it to its corresponding location in the tree.
-		newNodePtr = new MazeNodeOne(prizeCode, LEVEL_ONE_NUM_DIRECTIONS, atEnd, newKey);
-		startPtr = insertInLoc(startPtr, newNodePtr);
+		//The last node created is the finish.
+		if (balanced) //Priorities are only drawn for treaps
+		{
+			newNodePtr = createNode(prizeCode, atEnd, newKey, random.nextInt(INT_MAX));
+			insertBalanced(newNodePtr);
+		}
+		else
+		{
+			newNodePtr = createNode(prizeCode, atEnd, newKey);
+			startPtr = insertInLoc(startPtr, newNodePtr);
+		}
 
 		numNodes--;
 	} while (numNodes >= 1);
+
+	finishPtr = newNodePtr;
 }
 
 MazeNodeOne* MazeLevelOne::insertInLoc(MazeNodeOne* subTreePtr, MazeNodeOne* newNodePtr)
 {
-	if (subTreePtr)
-	{
-		MazeNodeOne* nextNode;
-		if (newNodePtr->getSortKey() < subTreePtr->getSortKey())
-		{ //newNode belongs to the left subtree
-			nextNode = insertInLoc(subTreePtr->getNextNodePtr(1), newNodePtr);
-			subTreePtr->setNextNodePtr(1, nextNode);
-			nextNode->setNextNodePtr(0, subTreePtr); //Connect new node to the parent (or reconnect)
-		}
-		else //Move to right subtree, for duplicate keys too
-		{
-			nextNode = insertInLoc(subTreePtr->getNextNodePtr(2), newNodePtr);
-			subTreePtr->setNextNodePtr(2, nextNode);
-			nextNode->setNextNodePtr(0, subTreePtr);
-		}
+	if (!subTreePtr) //Empty tree, so newNode is the insertion location
+		return newNodePtr;
 
-		return subTreePtr; //For reconnecting
+	MazeNodeOne* currentPtr = subTreePtr;
+	int pathIndex = (newNodePtr->getSortKey() < currentPtr->getSortKey() ? 1 : 2); //Left subtree, or the right
+	while (getNextNode(currentPtr, pathIndex)) //subtree for duplicate keys too
+	{
+		currentPtr = getNextNode(currentPtr, pathIndex);
+		pathIndex = (newNodePtr->getSortKey() < currentPtr->getSortKey() ? 1 : 2);
 	}
 
-	return newNodePtr; //Found the insertion location
+	setNextNode(currentPtr, pathIndex, newNodePtr); //Found the insertion location
+	setNextNode(newNodePtr, 0, currentPtr); //Connect new node to the parent
 
+	return subTreePtr; //For reconnecting
 }
 
-void MazeLevelOne::postOrderDelete(MazeNodeOne* subTreePtr)
+void MazeLevelOne::insertBalanced(MazeNodeOne* newNodePtr)
 {
-	if (subTreePtr)
+	MazeNodeOne* parentPtr = NULL; //Walk down to the insertion location, same as insertInLoc
+	MazeNodeOne* currentPtr = startPtr;
+	int pathIndex = 1;
+	while (currentPtr)
 	{
-		postOrderDelete(subTreePtr->getNextNodePtr(1));
-		postOrderDelete(subTreePtr->getNextNodePtr(2));
-		delete subTreePtr;
+		parentPtr = currentPtr;
+		pathIndex = (newNodePtr->getSortKey() < currentPtr->getSortKey() ? 1 : 2); //Duplicates go right
+		currentPtr = getNextNode(currentPtr, pathIndex);
 	}
+
+	setNextNode(parentPtr, pathIndex, newNodePtr); //Attach the new leaf
+	setNextNode(newNodePtr, 0, parentPtr);
+
+	//Restore the heap property by rotating the new node up. Note that the root has a priority
+	//of INT_MAX, so the loop always stops below it.
+	while (newNodePtr->getPriority() > getNextNode(newNodePtr, 0)->getPriority())
+		rotateUp(newNodePtr);
+}
+
+void MazeLevelOne::rotateUp(MazeNodeOne* nodePtr)
+{
+	MazeNodeOne* parentPtr = getNextNode(nodePtr, 0);
+	MazeNodeOne* grandParentPtr = getNextNode(parentPtr, 0);
+
+	int side = (getNextNode(parentPtr, 1) == nodePtr ? 1 : 2); //Which child of the parent nodePtr is
+	int otherSide = LEVEL_ONE_NUM_DIRECTIONS - side; //1 <-> 2
+
+	MazeNodeOne* innerChild = getNextNode(nodePtr, otherSide); //This subtree moves over to the parent
+	setNextNode(parentPtr, side, innerChild);
+	if (innerChild)
+		setNextNode(innerChild, 0, parentPtr);
+
+	setNextNode(nodePtr, otherSide, parentPtr); //The parent becomes the child of nodePtr
+	setNextNode(parentPtr, 0, nodePtr);
+
+	setNextNode(nodePtr, 0, grandParentPtr); //Reconnect nodePtr to the rest of the tree
+	if (grandParentPtr)
+		setNextNode(grandParentPtr, getNextNode(grandParentPtr, 1) == parentPtr ? 1 : 2, nodePtr);
+	else
+		startPtr = nodePtr;
 }
 
-MazeNodeOne* MazeLevelOne::copyTree(MazeNodeOne* subTreePtr, MazeNodeOne* otherTreePtr)
+MazeNodeOne* MazeLevelOne::copyTree(const MazeLevelOne& otherMaze, MazeNodeOne* otherTreePtr)
 {
 	if (otherTreePtr)
 	{
-		subTreePtr = new MazeNodeOne(*otherTreePtr); //Copy the contents of the node
+		MazeNodeOne* subTreePtr = createNode(*otherTreePtr); //Copy the contents of the root
+		if (subTreePtr->isFinish())
+			finishPtr = subTreePtr;
 
-		subTreePtr->setNextNodePtr(1, copyTree(subTreePtr->getNextNodePtr(1), //Copy left subtree
-							otherTreePtr->getNextNodePtr(1)));
-		(subTreePtr->getNextNodePtr(1))->setNextNodePtr(0, subTreePtr); //Connect for backwards direction
+		Stack<std::pair<MazeNodeOne*, MazeNodeOne*> > nodeStack; //Pairs of (other node, copy of the node)
+		nodeStack.push(std::make_pair(otherTreePtr, subTreePtr)); //whose children still have to be copied
+		while (!nodeStack.empty())
+		{
+			MazeNodeOne* otherPtr = nodeStack.top().first;
+			MazeNodeOne* newPtr = nodeStack.top().second;
+			nodeStack.pop();
 
-		subTreePtr->setNextNodePtr(2, copyTree(subTreePtr->getNextNodePtr(2), //Copy right subtree
-							otherTreePtr->getNextNodePtr(2)));
-		(subTreePtr->getNextNodePtr(2))->setNextNodePtr(0, subTreePtr);
+			for (int i = 1; i < LEVEL_ONE_NUM_DIRECTIONS; ++i) //Copy the left, then the right child
+			{
+				MazeNodeOne* otherChild = otherMaze.getNextNode(otherPtr, i);
+				if (otherChild)
+				{
+					MazeNodeOne* childPtr = createNode(*otherChild);
+					if (childPtr->isFinish())
+						finishPtr = childPtr;
+					setNextNode(newPtr, i, childPtr);
+					setNextNode(childPtr, 0, newPtr); //Connect for backwards direction
+					nodeStack.push(std::make_pair(otherChild, childPtr));
+				}
+			}
+		}
 
 		return subTreePtr;
 	}
@@ -120,107 +212,106 @@ MazeNodeOne* MazeLevelOne::copyTree(MazeNodeOne* subTreePtr, MazeNodeOne* otherT
 
 void MazeLevelOne::setPlayer(Player* newPlayer)
 {
-	if (playerPtr) //There was a game being played prior to setting the player, so we reset
-		resetNodes(startPtr); //the maze
+	setPlayer(ownOverlay, newPlayer);
+}
 
-	playerPtr = newPlayer;
-	playerPtr->resetNumItems(); //Reset the collectibles of the player in case they exist
-	playerLoc = startPtr;
+void MazeLevelOne::setPlayer(MazeOverlay& overlay, Player* newPlayer) const
+{
+	overlay.start(newPlayer, startPtr->getNodeIndex()); //Every prize is back in place
+	if (newPlayer)
+		newPlayer->resetNumItems(); //Reset the collectibles of the player in case they exist
 }
 
 int MazeLevelOne::movePlayer(int nextPathIndex)
 {
-	//Move only if a plyer exists and nextPathIndex is within the array bounds
-	int canMove = (playerPtr && 0 <= nextPathIndex && nextPathIndex < LEVEL_ONE_NUM_DIRECTIONS);
-	if (canMove)
+	MazeStats::Timer timer(stats, STATS_MOVE_PLAYER);
+	MoveEvent event = makeMove(nextPathIndex);
+	return printMoveEvent(event, (event.outcome == MOVE_INVALID ? "" : DIRECTION_NAMES[nextPathIndex]), ownOverlay.getPlayer());
+}
+
+inline MoveEvent MazeLevelOne::stepPlayer(MazeOverlay& overlay, MazeNodeOne*& location, int nextPathIndex) const
+{
+	Player* playerPtr = overlay.getPlayer();
+	MoveEvent event = {MOVE_INVALID, 0, 0, -1};
+
+	if (0 <= nextPathIndex && nextPathIndex < LEVEL_ONE_NUM_DIRECTIONS)
 	{
-		if (playerLoc->getNextNodePtr(nextPathIndex)) //Valid movement
+		MazeNodeOne* nextNode = getNextNode(location, nextPathIndex);
+		if (nextNode) //Valid movement
 		{
-			canMove = 0;
-			playerLoc = playerLoc->getNextNodePtr(nextPathIndex); //Move the player
-			if (!playerLoc->isFinish()) //Player did not reach the finish
+			location = nextNode; //Move the player
+			event.nodeId = location->getNodeIndex();
+			event.prize = (overlay.isCollected(event.nodeId) ? 0 : location->getPrizeNum()); //Check if the player won a prize
+			if (!location->isFinish()) //Player did not reach the finish
 			{
-				switch (playerLoc->getPrizeNum()) //Check if the player won a prize
-				{
-					case 1: //Player won a coin
-						std::cout << "Congratulations! You've received a coin!" << std::endl;
-						playerPtr->incrementQuantity(1);
-						std::cout << "You have " << playerPtr->getQuantity(1)
-							<< " coins." << std::endl;
-						playerLoc->resetPrize();
-						break;
-					case 2: //Player won a power
-						std::cout << "CONGRATULATIONS!! You've received a power!" << std::endl;
-						std::cout << "Activate it to reveal the next location that";
-						std::cout << " will lead you to the finish line!" << std::endl;
-						playerPtr->incrementQuantity(2);
-						std::cout << "You have " << playerPtr->getQuantity(2)
-							<< " powers to use." << std::endl;
-						playerLoc->resetPrize();
-						break;
-				}
-				std::cout << "Successfully moved "; //Tell the player the move
-				switch(nextPathIndex) //was successful
+				event.outcome = MOVE_SUCCESSFUL;
+				if (event.prize > 0)
 				{
-					case 1: //Index 1 = left
-						std::cout << "left.";
-						break;
-					case 2: //Index 2 = right
-						std::cout << "right.";
-						break;
-					default: //Index 0 = backwards
-						std::cout << "backwards.";
-						break;
+					playerPtr->incrementQuantity(event.prize); //Index 1 = coins, 2 = powers
+					overlay.collect(event.nodeId);
 				}
-				std::cout << std::endl;
 			}
-			else //Finish node is reached, so we calculate the player's score.
+			else //Finish node is reached, and it may also contain a prize
 			{
-				std::cout << "CONGRATULATIONS!!! You've successfully reached the finish line!" << std::endl;
-				if (playerLoc->getPrizeNum() > 0) //Check if the finish node
-				{				//also contains a prize
-					std::cout << "AND you're lucky! You've just stumbled upon an extra ";
-					switch (playerLoc->getPrizeNum())
-					{
-						case 1:
-							std::cout << "coin!" << std::endl;
-							playerPtr->incrementQuantity(1);
-							break;
-						case 2:
-							std::cout << "power!" << std::endl;
-							playerPtr->incrementQuantity(2);
-							break;
-						default:
-							break;
-					}
-				}
-				canMove = -1;
-
+				event.outcome = MOVE_FINISH;
+				if (event.prize > 0)
+					playerPtr->incrementQuantity(event.prize);
 			}
 		}
 		else if (nextPathIndex > 0) //Dead end, > 0 accounts for the case where player moves
 					//backwards from the starting position
 		{
-			std::cout << "You've hit a dead end and lost a life!" << std::endl;
 			playerPtr->decrementQuantity(0); //Decrement the life
-
-			if (playerPtr->getQuantity(0) == 0) //Game over if the player has no lives
-				canMove = -2;
-			else //Good to go otherwise, we tell the player how many lives they have left.
-			{
-				std::cout << "You have " << playerPtr->getQuantity(0) << " lives left, ";
-				std::cout << "and are still at the same intersection." << std::endl;
-				canMove = 0;
-			}
+			event.outcome = (playerPtr->getQuantity(0) == 0 ? MOVE_GAME_OVER : MOVE_DEAD_END);
 		}
 		else //Player tries to move backwards, but they are at the start so they can't
+			event.outcome = MOVE_AT_START;
+	}
+
+	event.livesLeft = playerPtr->getQuantity(0); //Also set for an invalid path index, the player exists
+	if (event.outcome != MOVE_SUCCESSFUL && event.outcome != MOVE_FINISH) //The player stayed where they were
+		event.nodeId = location->getNodeIndex();
+
+	return event;
+}
+
+MoveEvent MazeLevelOne::makeMove(int nextPathIndex)
+{
+	return MazeLevelOne::makeMove(ownOverlay, nextPathIndex); //Qualified, so that the call is not virtual
+}
+
+MoveEvent MazeLevelOne::makeMove(MazeOverlay& overlay, int nextPathIndex) const
+{
+	stats.addCalls(STATS_MAKE_MOVE); //Counted but not timed, see MazeStats.h
+	MoveEvent event = {MOVE_INVALID, 0, 0, -1};
+	if (overlay.getPlayer()) //Move only if a player exists
+	{
+		MazeNodeOne* location = nodeArena.getNode(overlay.getLocation());
+		event = stepPlayer(overlay, location, nextPathIndex);
+		overlay.setLocation(event.nodeId); //The player is at event.nodeId
+	}
+
+	return event;
+}
+
+int MazeLevelOne::makeMoves(const int* pathIndices, int numMoves, MoveEvent* events)
+{
+	int movesMade = 0;
+	if (ownOverlay.getPlayer())
+	{
+		MazeNodeOne* location = nodeArena.getNode(ownOverlay.getLocation()); //Kept in a local, so that it can stay in a register between the moves
+		bool gameEnded = false;
+		while (movesMade < numMoves && !gameEnded)
 		{
-			canMove = 0;
-			std::cout << "Cannot move backwards since you are already at the start!" << std::endl;
+			events[movesMade] = stepPlayer(ownOverlay, location, pathIndices[movesMade]);
+			gameEnded = (events[movesMade].outcome == MOVE_FINISH || events[movesMade].outcome == MOVE_GAME_OVER);
+			movesMade++;
 		}
+		ownOverlay.setLocation(location->getNodeIndex());
 	}
+	stats.addCalls(STATS_MAKE_MOVE, movesMade); //Once for the whole batch
 
-	return canMove;
+	return movesMade;
 }
 
 const char** MazeLevelOne::getPossiblePaths() const
@@ -238,48 +329,97 @@ int MazeLevelOne::getNumPaths() const
 	return LEVEL_ONE_NUM_DIRECTIONS;
 }
 
+int MazeLevelOne::getNodeIdLimit() const
+{
+	return getNumSlots();
+}
 
-bool MazeLevelOne::findPathToFinish(MazeNodeOne* subTreePtr) const
+int MazeLevelOne::writeNodeTables(int* nextNodes, int* nodeInfo) const
 {
-	if (subTreePtr)
+	uint32_t numSlots = getNumSlots();
+	for (uint32_t i = 0; i < numSlots; ++i) //Slots that are not in the maze stay dead ends
 	{
-		if (subTreePtr->isFinish()) //If node is the maze exit, we see that the path does exist
-			return true;
-		else //Internal node
-		{
-			bool pathExists = findPathToFinish(subTreePtr->getNextNodePtr(1)); //Check left subtree
-			if (!pathExists) //if the path exists. If it doesn't we check the right subTree
-				pathExists = findPathToFinish(subTreePtr->getNextNodePtr(2));
+		for (int pathIndex = 0; pathIndex < LEVEL_ONE_NUM_DIRECTIONS; ++pathIndex)
+			nextNodes[i * LEVEL_ONE_NUM_DIRECTIONS + pathIndex] = -1;
+		nodeInfo[i] = 0;
+	}
+
+	Stack<MazeNodeOne*> nodeStack; //Walks the nodes of the maze, in any order
+	nodeStack.push(startPtr);
+	while (!nodeStack.empty())
+	{
+		MazeNodeOne* nodePtr = nodeStack.top();
+		nodeStack.pop();
 
-			return pathExists; //Returns true if path does exist, false otherwise
+		uint32_t nodeIndex = nodePtr->getNodeIndex();
+		nodeInfo[nodeIndex] = nodePtr->getPrizeNum() + (nodePtr->isFinish() ? NODE_TABLE_FINISH : 0);
+		for (int pathIndex = 0; pathIndex < LEVEL_ONE_NUM_DIRECTIONS; ++pathIndex)
+		{
+			MazeNodeOne* nextNode = getNextNode(nodePtr, pathIndex);
+			nextNodes[nodeIndex * LEVEL_ONE_NUM_DIRECTIONS + pathIndex] = (nextNode ? int(nextNode->getNodeIndex()) : -1);
+			if (nextNode && pathIndex > 0)
+				nodeStack.push(nextNode);
 		}
 	}
-	else //We reached a dead end
-		return false;
+
+	return startPtr->getNodeIndex();
+}
+
+bool MazeLevelOne::findPathToFinish(MazeNodeOne* subTreePtr) const
+{
+	return (subTreePtr && subTreePtr->isOnFinishPath()); //NULL is a dead end
+}
+
+void MazeLevelOne::markFinishPath(bool onPath)
+{
+	for (MazeNodeOne* nodePtr = finishPtr; nodePtr; nodePtr = getNextNode(nodePtr, 0))
+		nodePtr->setOnFinishPath(onPath);
 }
 
 bool MazeLevelOne::reveal() const
 {
-	bool canReveal = (playerPtr && playerPtr->getQuantity(2) > 0); //We can only reveal
-	if (canReveal) //if there is a player in the maze, and that player has at least one power to use.
+	MazeStats::Timer timer(stats, STATS_REVEAL);
+	int pathIndex = revealPath();
+	if (pathIndex >= 0) //if there is a player in the maze, and that player had at least one power to use.
 	{
-		playerPtr->decrementQuantity(2); //Reduce the available powers by one
 		std::cout << "Consuming your power..." << std::endl;
-		if (findPathToFinish(playerLoc->getNextNodePtr(1))) //Check if finish is to the left
+		if (pathIndex == 1) //Finish is to the left
 			std::cout << "Go left to get to the maze exit!" << std::endl;
-		else if (findPathToFinish(playerLoc->getNextNodePtr(2))) //Check if finish is to the right
+		else if (pathIndex == 2) //Finish is to the right
 			std::cout << "Go right to get to the maze exit!" << std::endl;
 		else //Player has to go backwards
 			std::cout << "Go backwards to get to the maze exit!" << std::endl;
 	}
-	else if (playerPtr) //No powers to consume
+	else if (ownOverlay.getPlayer()) //No powers to consume
 		std::cout << "You have no power to use!" << std::endl;
 
-	return canReveal;
+	return (pathIndex >= 0);
+}
+
+int MazeLevelOne::revealPath() const
+{
+	return revealPath(ownOverlay);
+}
+
+int MazeLevelOne::revealPath(const MazeOverlay& overlay) const
+{
+	stats.addCalls(STATS_REVEAL_PATH);
+	Player* playerPtr = overlay.getPlayer();
+	if (!playerPtr || !playerPtr->decrementQuantity(2)) //We can only reveal if there is a player in the maze,
+		return -1;					//and that player has at least one power to use
+
+	MazeNodeOne* location = nodeArena.getNode(overlay.getLocation());
+	if (findPathToFinish(getNextNode(location, 1))) //Check if finish is to the left
+		return 1;
+	else if (findPathToFinish(getNextNode(location, 2))) //Check if finish is to the right
+		return 2;
+	else //Player has to go backwards
+		return 0;
 }
 
 int MazeLevelOne::calcScore() const
 {
+	Player* playerPtr = ownOverlay.getPlayer();
 
 	if (playerPtr) //Calculate the score only if a player exists in the maze
 	{
@@ -297,33 +437,56 @@ int MazeLevelOne::calcScore() const
 		return -1;
 }
 
-void MazeLevelOne::resetNodes(MazeNodeOne* subTreePtr) //Pre-order reset of the nodes
+void MazeLevelOne::startOver()
 {
-	if (subTreePtr)
-	{
-		subTreePtr->resetPrize();
-		resetNodes(subTreePtr->getNextNodePtr(1));
-		resetNodes(subTreePtr->getNextNodePtr(2));
-	}
+	startOver(ownOverlay);
 }
 
-void MazeLevelOne::startOver()
+void MazeLevelOne::startOver(MazeOverlay& overlay) const
 {
-	if (playerPtr)
+	MazeStats::Timer timer(stats, STATS_START_OVER);
+	if (overlay.getPlayer())
 	{
-		playerLoc = startPtr;
-		playerPtr->resetNumItems();
+		overlay.setLocation(startPtr->getNodeIndex());
+		overlay.getPlayer()->resetNumItems();
 	}
-	resetNodes(startPtr);
+	overlay.resetCollected(); //Puts back the prizes collected since the last reset
 }
 
 int MazeLevelOne::getHeight(MazeNodeOne* subTreePtr) const
 {
-	if (subTreePtr) //Height is 1 + max(height(left subtree), height(right subtree))
-		return 1 + std::max(getHeight(subTreePtr->getNextNodePtr(1)),
-					getHeight(subTreePtr->getNextNodePtr(2)));
-	else //Note that an empty tree has height 0
-		return 0;
+	int height = 0; //Note that an empty tree has height 0
+	int depth = 1; //Depth of nodePtr, kept up to date while walking the parent links
+	MazeNodeOne* nodePtr = subTreePtr;
+	while (nodePtr) //Pre-order walk, tracking the depth of each node
+	{
+		height = std::max(height, depth);
+
+		MazeNodeOne* nextPtr = NULL;
+		for (int i = 1; i < LEVEL_ONE_NUM_DIRECTIONS && !nextPtr; ++i)
+			nextPtr = getNextNode(nodePtr, i);
+
+		if (nextPtr) //Moving down a level
+			depth++;
+		else //Climb back up, one level at a time
+		{
+			while (nodePtr != subTreePtr && !nextPtr)
+			{
+				MazeNodeOne* parentPtr = getNextNode(nodePtr, 0);
+				if (getNextNode(parentPtr, 1) == nodePtr && getNextNode(parentPtr, 2))
+					nextPtr = getNextNode(parentPtr, 2); //Sibling is at the same depth
+				else
+				{
+					nodePtr = parentPtr;
+					depth--;
+				}
+			}
+		}
+
+		nodePtr = nextPtr;
+	}
+
+	return height;
 }
 
 int MazeLevelOne::powTwo(int exponent) const
@@ -331,6 +494,183 @@ int MazeLevelOne::powTwo(int exponent) const
 	return (1 << exponent); //Left shift to compute the power of 2
 }
 
+size_t MazeLevelOne::getArenaBytesUsed() const
+{
+	return nodeArena.getBytesUsed();
+}
+
+int MazeLevelOne::getArenaChunks() const
+{
+	return nodeArena.getNumChunks();
+}
+
+void MazeLevelOne::readShape(MazeStatsReport& report) const
+{
+	report.level = 1;
+	report.nodesAllocated = nodeArena.getBytesUsed() / sizeof(MazeNodeOne);
+	report.bytesUsed = nodeArena.getBytesUsed();
+	report.depth = 0;
+	report.deadEnds = report.coins = report.powers = 0;
+
+	Stack<MazeNodeOne*> nodeStack; //Depth first walk, the depth of each node being kept alongside it
+	Stack<int> depthStack;
+	nodeStack.push(startPtr);
+	depthStack.push(1);
+	while (!nodeStack.empty())
+	{
+		MazeNodeOne* nodePtr = nodeStack.top();
+		int depth = depthStack.top();
+		nodeStack.pop();
+		depthStack.pop();
+
+		report.depth = std::max(report.depth, depth);
+		int prizeNum = nodePtr->getPrizeNum();
+		report.coins += (prizeNum == 1);
+		report.powers += (prizeNum == 2);
+
+		for (int i = 1; i < LEVEL_ONE_NUM_DIRECTIONS && !nodePtr->isFinish(); ++i) //The player stops at the finish
+		{
+			MazeNodeOne* childPtr = getNextNode(nodePtr, i);
+			if (childPtr)
+			{
+				nodeStack.push(childPtr);
+				depthStack.push(depth + 1);
+			}
+			else
+				report.deadEnds++;
+		}
+	}
+}
+
+uint64_t MazeLevelOne::getSeed() const
+{
+	return random.getSeed();
+}
+
+uint32_t MazeLevelOne::getNumSlots() const
+{
+	int numChunks = nodeArena.getNumChunks();
+	return (numChunks > 0 ? uint32_t(numChunks - 1) * nodeArena.getNodesPerChunk() + nodeArena.getChunkSlots(numChunks - 1) : 0);
+}
+
+/*
+Returns true if the numNodes nodes of a maze image hold a maze: every node knows its own index, every node
+other than the start links back to a parent that comes before it, every child links back to the node
+linking to it, and the finish, if there is one, is the only node flagged as the maze exit. The numNodes - 1
+child links then lead to distinct nodes other than the start, so every node is the child of its parent,
+and the parents of any node lead back to the start: the nodes form a tree, with no walk needed. Since the
+nodes are saved in breadth-first order, the children are also met in order, so this reads the image
+almost sequentially, in O(n).
+*/
+static bool checkNodes(const MazeNodeOne* nodes, uint32_t numNodes, uint32_t startId, uint32_t finishId)
+{
+	if (startId >= numNodes || (finishId != NULL_NODE_INDEX && finishId >= numNodes))
+		return false;
+
+	uint32_t numChildren = 0;
+	for (uint32_t i = 0; i < numNodes; ++i)
+	{
+		const MazeNodeOne& node = nodes[i];
+		uint8_t flags = node.getFlags();
+		uint32_t parentId = node.getNextNodePtr(0);
+		if ((flags & ~(NODE_ONE_PRIZE_MASK | NODE_ONE_FINISH | NODE_ONE_ON_FINISH_PATH)) != 0
+			|| (flags & NODE_ONE_PRIZE_MASK) > 2 || ((flags & NODE_ONE_FINISH) != 0) != (i == finishId)
+			|| node.getNodeIndex() != i || (i == startId ? parentId != NULL_NODE_INDEX : parentId >= i))
+			return false;
+
+		for (int pathIndex = 1; pathIndex < LEVEL_ONE_NUM_DIRECTIONS; ++pathIndex)
+		{
+			uint32_t childId = node.getNextNodePtr(pathIndex);
+			if (childId != NULL_NODE_INDEX)
+			{
+				if (childId >= numNodes || nodes[childId].getNextNodePtr(0) != i
+					|| (pathIndex > 1 && childId == node.getNextNodePtr(1)))
+					return false;
+				numChildren++;
+			}
+		}
+	}
+
+	return (numChildren == numNodes - 1); //Otherwise some nodes are nobody's child
+}
+
+bool MazeLevelOne::save(const char* fileName) const
+{
+	uint32_t numNodes = uint32_t(nodeArena.getBytesUsed() / sizeof(MazeNodeOne)); //The released nodes are left out
+	MazeImage newImage;
+	bool saved = newImage.create(fileName, 1, sizeof(MazeNodeOne), numNodes, 0, NULL_NODE_INDEX, random.getSeed());
+
+	//The nodes are renumbered in breadth-first order, so that every parent comes before its children, which
+	//is what lets load check the image in one pass (see checkNodes). Each node of the queue is written along
+	//with its new index, which is its position in the queue, and the new index of its parent.
+	Queue<MazeNodeOne*> nodeQueue;
+	Queue<uint32_t> parentQueue;
+	nodeQueue.push(startPtr);
+	parentQueue.push(NULL_NODE_INDEX);
+	uint32_t nodeId = 0; //New index of the node at the front of the queue
+	uint32_t nextId = 1; //New index of the next node pushed
+	uint32_t nodesPerBuffer = nodeArena.getNodesPerChunk();
+	MazeNodeOne* records = new MazeNodeOne[nodesPerBuffer]; //Written a chunk's worth at a time
+	uint32_t numRecords = 0;
+	while (!nodeQueue.empty() && saved)
+	{
+		MazeNodeOne* nodePtr = nodeQueue.front();
+		MazeNodeOne* recordPtr = new (records + numRecords++) MazeNodeOne(*nodePtr); //All but the links and the index
+		recordPtr->setNodeIndex(nodeId);
+		recordPtr->setNextNodePtr(0, parentQueue.front());
+		nodeQueue.pop();
+		parentQueue.pop();
+		if (nodePtr == finishPtr)
+			newImage.setFinishId(nodeId);
+
+		for (int pathIndex = 1; pathIndex < LEVEL_ONE_NUM_DIRECTIONS; ++pathIndex)
+		{
+			MazeNodeOne* nextNode = getNextNode(nodePtr, pathIndex);
+			if (nextNode)
+			{
+				recordPtr->setNextNodePtr(pathIndex, nextId++);
+				nodeQueue.push(nextNode);
+				parentQueue.push(nodeId);
+			}
+		}
+		nodeId++;
+
+		if (numRecords == nodesPerBuffer || nodeQueue.empty())
+		{
+			saved = newImage.writeSection(0, records, numRecords * sizeof(MazeNodeOne));
+			numRecords = 0;
+		}
+	}
+
+	delete [] records;
+	return newImage.finish() && saved && nodeId == numNodes;
+}
+
+bool MazeLevelOne::load(const char* fileName)
+{
+	stats.startGeneration(); //Only finished if the image is loaded
+	MazeImage newImage;
+	if (!newImage.map(fileName, 1))
+		return false;
+
+	MazeImageHeader header = newImage.getHeader();
+	MazeNodeOne* nodes = reinterpret_cast<MazeNodeOne*>(newImage.getSection(0, uint64_t(header.nodeCount) * sizeof(MazeNodeOne)));
+	if (!nodes || header.nodeSize != sizeof(MazeNodeOne) || header.nodeCount > INT_MAX
+		|| !checkNodes(nodes, header.nodeCount, header.startId, header.finishId))
+		return false;
+
+	nodeArena.adopt(nodes, header.nodeCount); //The nodes are played from the image as they are
+	image.swap(newImage); //The previous image, if any, is unmapped along with newImage
+	random.setSeed(header.seed);
+
+	startPtr = nodeArena.getNode(header.startId);
+	finishPtr = (header.finishId == NULL_NODE_INDEX ? NULL : nodeArena.getNode(header.finishId));
+	setPlayer(ownOverlay, ownOverlay.getPlayer()); //Back to the start, like startOver
+	stats.finishGeneration();
+
+	return true;
+}
+
 void MazeLevelOne::displayMaze() const //Do the level order traversal of the maze
 {
 	int treeHeight = getHeight(startPtr);
@@ -358,14 +698,14 @@ void MazeLevelOne::displayMaze() const //Do the level order traversal of the maz
 
 			if (!currentNode->isFinish()) //If the node is not the finish,
 			{
-				if (playerLoc != currentNode) //Check if the player is at the node
+				if (ownOverlay.getLocation() != int(currentNode->getNodeIndex())) //Check if the player is at the node
 					std::cout << "O";
 				else
 					std::cout << "P";
 
 				for (int i = 1; i < LEVEL_ONE_NUM_DIRECTIONS; ++i)
 				{ //Place the children in the queue
-					MazeNodeOne* childPtr = currentNode->getNextNodePtr(i);
+					MazeNodeOne* childPtr = getNextNode(currentNode, i);
 					ptrQueue.push(childPtr);
 					if (!childPtr)
 						nullQueue.push(1); //We need to display this node, it's a dead end
@@ -435,11 +775,20 @@ FOR THE PRESENT PROGRAM!!!*/
 
 void MazeLevelOne::traverse(MazeNodeOne* subTreePtr) const //Conduct an inorder traversal of the tree
 {
-	if (subTreePtr)
+	Stack<MazeNodeOne*> nodeStack;
+	MazeNodeOne* nodePtr = subTreePtr;
+	while (nodePtr || !nodeStack.empty())
 	{
-		traverse(subTreePtr->getNextNodePtr(1));
-		std::cout << subTreePtr->getSortKey() << " ";
-		traverse(subTreePtr->getNextNodePtr(2));
+		while (nodePtr)
+		{
+			nodeStack.push(nodePtr);
+			nodePtr = getNextNode(nodePtr, 1);
+		}
+
+		nodePtr = nodeStack.top();
+		nodeStack.pop();
+		std::cout << nodePtr->getSortKey() << " ";
+		nodePtr = getNextNode(nodePtr, 2);
 	}
 }
 
@@ -450,15 +799,8 @@ void MazeLevelOne::displayAll() const //Display the tree in order fashion
 
 MazeNodeOne* MazeLevelOne::findNode(MazeNodeOne* treePtr, int sortKey) const //Locate the node having a sortKey
 {									    //of sortKey
-	if (treePtr)
-	{
-		if (treePtr->getSortKey() == sortKey)
-			return treePtr;
-		else if (sortKey < treePtr->getSortKey())
-			treePtr = findNode(treePtr->getNextNodePtr(1), sortKey);
-		else
-			treePtr = findNode(treePtr->getNextNodePtr(2), sortKey);
-	}
+	while (treePtr && treePtr->getSortKey() != sortKey)
+		treePtr = getNextNode(treePtr, sortKey < treePtr->getSortKey() ? 1 : 2);
 
 	return treePtr;
 }
@@ -475,17 +817,16 @@ int MazeLevelOne::getEntry(int sortKey) const //Return the sortKey of the node i
 MazeNodeOne* MazeLevelOne::removeValue(MazeNodeOne* treePtr, int sortKey, bool& successful)
 {
 	//We search for the node having a sortKeey of sortKey
-	if (treePtr)
+	MazeNodeOne* nodePtr = findNode(treePtr, sortKey);
+	if (nodePtr) //Found it
 	{
-		if (treePtr->getSortKey() == sortKey) //Found it
-		{
-			successful = true;
-			treePtr = deleteNode(treePtr); //We delete the node
-		}
-		else if (sortKey < treePtr->getSortKey()) //Check left subtree
-			treePtr->setNextNodePtr(1, removeValue(treePtr->getNextNodePtr(1), sortKey, successful));
-		else //Check right subtree
-			treePtr->setNextNodePtr(2, removeValue(treePtr->getNextNodePtr(2), sortKey, successful));
+		successful = true;
+		if (nodePtr == treePtr) //Removing the root of the subtree, so the replacement is the new root
+			return deleteNode(nodePtr);
+
+		MazeNodeOne* parentPtr = getNextNode(nodePtr, 0);
+		int pathIndex = (getNextNode(parentPtr, 1) == nodePtr ? 1 : 2);
+		setNextNode(parentPtr, pathIndex, deleteNode(nodePtr)); //We delete the node and reconnect
 	}
 
 	return treePtr;
@@ -493,47 +834,62 @@ MazeNodeOne* MazeLevelOne::removeValue(MazeNodeOne* treePtr, int sortKey, bool&
 
 MazeNodeOne* MazeLevelOne::swapSuccessor(MazeNodeOne* treePtr, MazeNodeOne* nodeToSwap)
 {
-	if (treePtr->getNextNodePtr(1)) //We haven't found the inorder successor
-		treePtr->setNextNodePtr(1, swapSuccessor(treePtr->getNextNodePtr(1), nodeToSwap));
-	else
-	{
-		*nodeToSwap = *treePtr; //Swap the contents of the node with its inorder succcessor
+	MazeNodeOne* successorPtr = treePtr; //The inorder successor is the leftmost node of treePtr
+	while (getNextNode(successorPtr, 1))
+		successorPtr = getNextNode(successorPtr, 1);
 
-		MazeNodeOne* storeNext = treePtr->getNextNodePtr(2); //Get the right child of the inorder
-		if (storeNext) //successor to connect to its parent
-			storeNext->setNextNodePtr(0, treePtr->getNextNodePtr(0)); //Connect to parent if
-										//child exists
-		delete treePtr;
+	*nodeToSwap = *successorPtr; //Swap the contents of the node with its inorder succcessor
+	if (successorPtr == finishPtr) //The finish moves along with the contents
+		finishPtr = nodeToSwap;
+
+	MazeNodeOne* parentPtr = getNextNode(successorPtr, 0);
+	MazeNodeOne* storeNext = getNextNode(successorPtr, 2); //Get the right child of the inorder
+	if (storeNext) //successor to connect to its parent
+		setNextNode(storeNext, 0, parentPtr);
+
+	if (successorPtr == treePtr) //The successor was the root of the subtree
 		treePtr = storeNext;
-	}
+	else
+		setNextNode(parentPtr, 1, storeNext);
+
+	nodeArena.release(successorPtr->getNodeIndex());
 
 	return treePtr; //For reconnecting
 }
 
 MazeNodeOne* MazeLevelOne::deleteNode(MazeNodeOne* treePtr)
 {
-	if (!treePtr->getNextNodePtr(1) && !treePtr->getNextNodePtr(2)) //Leaf
+	if (treePtr == finishPtr) //Whichever case applies below, the contents of treePtr are gone,
+		finishPtr = NULL; //so removing the finish leaves the maze without one
+
+	if (!getNextNode(treePtr, 1) && !getNextNode(treePtr, 2)) //Leaf
 	{
-		delete treePtr;
+		nodeArena.release(treePtr->getNodeIndex());
 		return NULL;
 	}
-	else if (!treePtr->getNextNodePtr(2)) //No inorder successor, but node does have a left child
+	else if (!getNextNode(treePtr, 2)) //No inorder successor, but node does have a left child
 	{ //so we connect the leftChild to the node's parent, delete the node, and return a left child pointer
-		MazeNodeOne* leftChild = treePtr->getNextNodePtr(1);
-		leftChild->setNextNodePtr(0, treePtr->getNextNodePtr(0));
-		delete treePtr;
+		MazeNodeOne* leftChild = getNextNode(treePtr, 1);
+		setNextNode(leftChild, 0, getNextNode(treePtr, 0));
+		nodeArena.release(treePtr->getNodeIndex());
 		return leftChild;
 	}
 	else //There is an inorder successor, so we search for it, swap, and then remove it
 	{
-		treePtr->setNextNodePtr(2, swapSuccessor(treePtr->getNextNodePtr(2), treePtr));
+		setNextNode(treePtr, 2, swapSuccessor(getNextNode(treePtr, 2), treePtr));
 		return treePtr;
 	}
 }
 
 bool MazeLevelOne::removeEntry(int sortKey) //Removes the node having a sortKey of sortKey
 {
+	if (image.isMapped()) //The nodes of a loaded maze are in read only memory
+		return false;
+
 	bool successful = false;
+	ownOverlay.resetCollected(); //The removal can move the prizes of the nodes around
+	markFinishPath(false); //The removal can move the finish or restructure its path
 	startPtr = removeValue(startPtr, sortKey, successful);
+	markFinishPath(true);
 	return successful;
 }
@@ -7,16 +7,25 @@ A binary search tree (BST) is used as the corresponding data structure.
 Here, the user has up to three directions they can take:
 
 B = Backward, L = Left, and R = Right.
+
+Since the sort keys are drawn from a small distribution, a plain BST built from them degenerates into
+long right spines for large mazes. The maze can therefore also be built as a treap, where every node gets
+a random heap priority and is rotated up the tree on insertion. This keeps the expected depth of the tree
+at O(log n) while the Backward/Left/Right semantics of the maze stay the same.
 */
 
+#include "MazeImage.h"
 #include "MazeInterface.h"
 #include "MazeNodeOne.h"
+#include "MazeRandom.h"
+#include "NodeArena.h"
 #include "Player.h"
+#include "Stack.h"
 
 #include <cstdlib>
 
 const int DEFAULT_LEVEL_ONE_NODE_NUM = 4; //Default number of nodes in level 1 of the maze
-const int LEVEL_ONE_NUM_DIRECTIONS = 3; //Number of possible paths that the player can take,
+const int LEVEL_ONE_NUM_DIRECTIONS = NODE_ONE_NUM_PATHS; //Number of possible paths that the player can take,
 //for the present project, index 0 = backwards, index 1 = left, index 2 = right
 const int KEY_DIST_SIZE = 100; //Size of the distribution of the keys for the level.
 
@@ -33,13 +42,27 @@ class MazeLevelOne : public MazeInterface
 {
 public:
 	//Constructor, takes the number of nodes in the maze (i.e. valid intersections) as input.
-	MazeLevelOne(int numNodes = DEFAULT_LEVEL_ONE_NODE_NUM);
+	//If balanced is true, the maze is built as a treap to bound its depth (see above).
+	//The maze is generated from a seed drawn from rand() (see MazeRandom::makeSeed).
+	MazeLevelOne(int numNodes = DEFAULT_LEVEL_ONE_NODE_NUM, bool balanced = false);
+
+	//Same as above, but the maze is generated from seed, so the same arguments always give the same maze.
+	MazeLevelOne(int numNodes, bool balanced, uint64_t seed);
 	MazeLevelOne(const MazeLevelOne&); //Copy constructor
 	~MazeLevelOne(); //Destructor
 
 	void setPlayer(Player* newPlayer); //Described in maze interface
+	void setPlayer(MazeOverlay& overlay, Player* newPlayer) const; //Described in maze interface
 	int movePlayer(int nextPathIndex); //Described in maze interface
 
+	/*
+	Described in maze interface. The ID of a node is its index in the arena that stores the maze (see
+	MazeNodeOne::getNodeIndex).
+	*/
+	MoveEvent makeMove(int nextPathIndex);
+	MoveEvent makeMove(MazeOverlay& overlay, int nextPathIndex) const;
+	int makeMoves(const int* pathIndices, int numMoves, MoveEvent* events); //Described in maze interface
+
 	/*
 	Described in maze interface. Here, a pointer, call it ptr, is returned having the following strings
 	at its indices:
@@ -51,9 +74,14 @@ public:
 	*/
 	const char** getPossiblePaths() const;
 	int getNumPaths() const; //Described in maze interface
+	int getNodeIdLimit() const; //Described in maze interface, the IDs are the indices of the arena slots
+	int writeNodeTables(int* nextNodes, int* nodeInfo) const; //Described in maze interface
 	bool reveal() const; //Described in maze interface
+	int revealPath() const; //Described in maze interface
+	int revealPath(const MazeOverlay& overlay) const; //Described in maze interface
 	int calcScore() const; //Described in maze interface
 	void startOver(); //Described in maze interface
+	void startOver(MazeOverlay& overlay) const; //Described in maze interface
 
 	/*
 	Outputs the tree in level order fashion, showing all of the intersections, the player,
@@ -70,23 +98,100 @@ public:
 	*/
 	void displayMaze() const;
 
+	/*
+	Return the number of bytes used by the nodes of the maze, and the number of arena chunks
+	that were allocated to store them.
+	*/
+	size_t getArenaBytesUsed() const;
+	int getArenaChunks() const;
+
+	/*
+	Returns the seed the maze was generated from. Passing it back to the constructor, along with the
+	same number of nodes and balanced flag, rebuilds the same maze.
+	*/
+	uint64_t getSeed() const;
+
+	/*
+	Saves the maze into a maze image (see MazeImage), so that it can be loaded again without rebuilding it.
+	Section 0 of the image holds the nodes of the maze, each one a MazeNodeOne laid out as it is in
+	memory. They are renumbered in breadth-first order from the start, so the start is node 0 and every
+	parent comes before its children, and the released nodes are left out. The header holds the index of
+	the finish (NULL_NODE_INDEX if it was removed). The node IDs of a loaded maze are the new indices.
+	@return: True if the image was written, false otherwise.
+	*/
+	bool save(const char* fileName) const;
+
+	/*
+	Replaces the maze with the one saved in fileName. The image is mapped into memory, its nodes are
+	checked to hold a maze, in O(n) but without writing anything, and the maze is played straight from
+	the mapping, whose nodes are never copied or changed. If there is a player, they are moved to the
+	start and their collectibles are reset, as in startOver.
+	@return: True if the maze was loaded. False if the file is not a Level 1 image written by this
+	version of the program, or its nodes do not hold a maze, in which case the maze is left as it was.
+	The overlays other than the one owned by the maze must be started again with setPlayer before they
+	are played in the new maze.
+	*/
+	bool load(const char* fileName);
+
+protected:
+	/*
+	Described in maze interface. The depth is the height of the tree above the finish, and every missing
+	left or right child of an intersection other than the finish is a dead end.
+	*/
+	void readShape(MazeStatsReport& report) const;
+
 private:
-	Player* playerPtr; //Pointer to store the player
-	MazeNodeOne* playerLoc; //Pointer to store the player's location in the maze
+	NodeArena<MazeNodeOne> nodeArena; //Stores the nodes of the maze, freed all at once on destruction
+	MazeRandom random; //Generates the keys, prizes and priorities of the nodes
+	MazeOverlay ownOverlay; //Game played by the functions that take no overlay
 	MazeNodeOne* startPtr; //Pointer to store the starting location of the maze
+	MazeNodeOne* finishPtr; //Pointer to the maze exit, NULL if it was removed
+	MazeImage image; //Image the nodes of the arena point into if the maze was loaded, see load
+
+	/*
+	Creates a new node in nodeArena, passing args to the MazeNodeOne constructor, and records its index
+	in the node.
+	@return: A pointer to the new node.
+	*/
+	template <class... Args>
+	MazeNodeOne* createNode(Args&&... args);
+
+	/*
+	The links of the nodes are indices into nodeArena (see MazeNodeOne). These resolve and set them,
+	with NULL standing for a dead end just like it did for pointer links.
+	*/
+	MazeNodeOne* getNextNode(const MazeNodeOne* nodePtr, int pathIndex) const;
+	void setNextNode(MazeNodeOne* nodePtr, int pathIndex, MazeNodeOne* nextNode);
+
+	/*
+	Moves the player of overlay, who must exist, from location towards nextPathIndex. Used by makeMove
+	and makeMoves, which pass the node at the location of the overlay.
+	@post: location is the player's location after the move, and the prize collected, if any, is
+	marked in overlay.
+	@return: The result of the move, see MazeInterface::makeMove.
+	*/
+	MoveEvent stepPlayer(MazeOverlay& overlay, MazeNodeOne*& location, int nextPathIndex) const;
+
+	/*
+	Returns the number of slots of nodeArena that were handed out, the unused ones of the last chunk
+	excluded, which is the number of node IDs.
+	*/
+	uint32_t getNumSlots() const;
 
 	/*
 	Builds a maze having the number of nodes specified by numNodes, excluding the starting
 	location. The last node of the maze is the finish
 	@para numNodes: The number of nodes the maze will have.
+	balanced: If true, the nodes are inserted with insertBalanced instead of insertInLoc
 	@post: A maze having numNodes + 1 nodes, (+1 is for the starting location) is created,
 	with a random distribution of prizes and nodes. The last node created is the maze exit.
 	*/
-	void buildMaze(int numNodes);
+	void buildMaze(int numNodes, bool balanced);
 
 
 	/*
-	Inserts newNode into the maze using the generic BST insertion algorithm.
+	Inserts newNode into the maze using the generic BST insertion algorithm, walking down
+	the tree with a loop.
 	@param: subTreePtr - Pointer to the root of the subtree
 	newNode - Pointer to the new node to be inserted.
 	@post: newNode is inserted
@@ -97,36 +202,48 @@ private:
 	MazeNodeOne* insertInLoc(MazeNodeOne* subTreePtr, MazeNodeOne* newNode);
 
 	/*
-	Deletes all of the nodes in the entire maze in a postOrder fashion.
-	@post: The maze is empty.
-
-	NOTE: This is the REMOVE-ALL function for the data structure.
+	Inserts newNode into the maze using treap insertion: newNode is first inserted as a leaf
+	exactly like insertInLoc, then rotated up while its priority is greater than its parent's.
+	The starting node has the largest possible priority, so it always remains the root.
+	@param: newNode - Pointer to the new node to be inserted.
+	@post: newNode is inserted, and the tree is a valid treap.
 	*/
-	void postOrderDelete(MazeNodeOne* subTreePtr);
+	void insertBalanced(MazeNodeOne* newNode);
 
+	/*
+	Rotates nodePtr above its parent, keeping the in-order sequence of the tree and the backwards
+	(parent) links intact.
+	@post: The parent of nodePtr is now its child. startPtr is updated if nodePtr becomes the root.
+	*/
+	void rotateUp(MazeNodeOne* nodePtr);
 
 	/*
-	Copies the contents of the maze pointed to by otherTreePtr to the present maze.
-	@param subTreePtr - Pointer to the root of the new subtree to be created
+	Copies the contents of the maze pointed to by otherTreePtr to the present maze, using an
+	explicit stack of the nodes whose children still have to be copied.
+	@param otherMaze - The maze being copied, whose arena resolves the links of its nodes
 	otherTreePtr - Pointer to the root of the other tree's subtree
 	@return: A pointer to reconnect the tree.
 	*/
-	MazeNodeOne* copyTree(MazeNodeOne* subTreePtr, MazeNodeOne* otherTreePtr);
+	MazeNodeOne* copyTree(const MazeLevelOne& otherMaze, MazeNodeOne* otherTreePtr);
 
 	/*
-	Checks if a path to the maze exit exists starting at subTreePtr.
+	Checks if a path to the maze exit exists starting at subTreePtr. The finish is in the subtree
+	exactly when subTreePtr lies on the path from the start to the finish, so this only reads the
+	mark left by markFinishPath and takes constant time.
 	@return: True if a path does exist, false otherwise.
 	*/
 	bool findPathToFinish(MazeNodeOne* subTreePtr) const;
 
 	/*
-	Recursively resets the prizes in each node via a pre-order fashion.
-	@post: All prizes in the maze are resetted
+	Sets the finish path mark of every node from finishPtr up to the start to onPath, following
+	the parent links (path index 0). Must be called with false before the tree is restructured,
+	and with true once it is done.
 	*/
-	void resetNodes(MazeNodeOne* subTreePtr);
+	void markFinishPath(bool onPath);
 
 	/*
-	Returns the height of the tree
+	Returns the height of the tree. Walks the tree in pre-order, climbing back up through the
+	parent links (path index 0), so it needs no stack.
 	*/
 	int getHeight(MazeNodeOne* subTreePtr) const;
 
@@ -144,7 +261,7 @@ private:
 	overall assignment grade, hence why they do not follow the style guidelines.
 
 	Note that insert and remove-all were used in the present project, and hence are a part
-	of the core functions above (see insertInLoc and postOrderDelete).
+	of the core functions above (see insertInLoc, and nodeArena which frees the whole tree at once).
 	*/
 
 	/*
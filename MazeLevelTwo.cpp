@@ -4,143 +4,138 @@ in the header file.
 */
 
 #include "MazeLevelTwo.h"
-#include "Stack.h"
 
+#include <algorithm>
+#include <climits>
 #include <iostream>
+#include <utility>
 
-MazeLevelTwo::MazeLevelTwo(int numNodes)
-	: playerPtr(NULL), playerLoc(NULL)
+const char* const DIRECTION_NAMES[LEVEL_TWO_NUM_DIRECTIONS] = {"backwards", "straight", "left", "right", "diagonal"}; //Used by movePlayer
+
+MazeLevelTwo::MazeLevelTwo(int numNodes) : MazeLevelTwo(numNodes, MazeRandom::makeSeed())
+{
+}
+
+MazeLevelTwo::MazeLevelTwo(int numNodes, uint64_t seed) : random(seed)
 {
 	if (numNodes <= 2) //There has to be at least two nodes
 		numNodes = DEFAULT_LEVEL_TWO_NODE_NUM;
-
-	arraySize = numNodes;
-
-	listArray = new MazeNodeTwo*[arraySize];
-	for (int i = 0; i < numNodes; listArray[i++] = NULL);
+	else if (numNodes > MAX_LEVEL_TWO_NODE_NUM) //The edges could not hold the IDs of the nodes
+		numNodes = MAX_LEVEL_TWO_NODE_NUM;
 
 	buildMaze(numNodes);
+	computeFinishTable();
+	stats.finishGeneration(); //Started along with the maze
 }
 
 MazeLevelTwo::MazeLevelTwo(const MazeLevelTwo& otherMaze)
+	: random(otherMaze.random.getSeed()), nodeCount(otherMaze.nodeCount), finishId(otherMaze.finishId)
 {
-	playerPtr = NULL;
-	playerLoc = NULL;
-	arraySize = otherMaze.arraySize;
-
-	int arrayIndex = 0;
+	allocateArrays(nodeCount); //The arrays already have the final node count, so they are copied as they are
 
-	listArray = new MazeNodeTwo*[arraySize];
-	listArray[arrayIndex++] = copyMaze(otherMaze.listArray[0]);
-	Queue<MazeNodeTwo*> nodeQueue; //Copied the shape of the graph
-	nodeQueue.push(listArray[0]);
-	while (!nodeQueue.empty()) //Now we allocate the nodes to listArray using breadth order traversal
+	for (int i = 0; i < nodeCount; ++i)
 	{
-		MazeNodeTwo* nodePtr = nodeQueue.front();
-		nodeQueue.pop();
-
-		for (int i = 1; i < LEVEL_TWO_NUM_DIRECTIONS; ++i)
-		{
-			MazeNodeTwo* childPtr = nodePtr->getNextNodePtr(i);
-			if (childPtr)
-			{
-				listArray[arrayIndex++] = childPtr;
-				nodeQueue.push(childPtr);
-			}
-		}
+		edgeOffsets[i] = otherMaze.edgeOffsets[i];
+		parentEdges[i] = otherMaze.parentEdges[i];
+		prizes[i] = otherMaze.prizes[i]; //The game of the other maze is not copied, only the maze
+		nextHop[i] = otherMaze.nextHop[i];
+		finishDistance[i] = otherMaze.finishDistance[i];
 	}
+	edgeOffsets[nodeCount] = otherMaze.edgeOffsets[nodeCount];
+
+	for (int i = 0; i < nodeCount - 1; ++i)
+		edges[i] = otherMaze.edges[i];
+	stats.finishGeneration(); //Counts the time taken by the copy, whose counters start at 0
 }
 
 MazeLevelTwo::~MazeLevelTwo()
 {
-	removeAll();
+	deallocateArrays();
 }
 
-void MazeLevelTwo::removeAll()
+void MazeLevelTwo::allocateArrays(int numNodes)
 {
-	Stack<MazeNodeTwo*> nodeStack; //Use a stack to carry out the deletion
-	nodeStack.push(listArray[0]); //Stack will store the next intersection/"Node" that will be deleted
-	while (!nodeStack.empty())
-	{
-		MazeNodeTwo* currentNodePtr = nodeStack.top();
-		nodeStack.pop();
-		for (int i = 1; i < LEVEL_TWO_NUM_DIRECTIONS; ++i)
-		{
-			MazeNodeTwo* nextNode = currentNodePtr->getNextNodePtr(i);
-			if (nextNode) //Get the non-NULL intersections of the node,
-				nodeStack.push(nextNode); //and store them onto the stack
-		}
-		delete currentNodePtr; //Delete the current node after, and move on to the next intersection
-	}
-
-	delete [] listArray; //No need to delete the individual members of listArray, as the nodes they point to have
-				//already been deallocated from above
+	edgeOffsets = new int[numNodes + 1];
+	edges = new int[numNodes - 1]; //The maze is a tree, so every node but the start has exactly one parent
+	parentEdges = new int[numNodes];
+	prizes = new signed char[numNodes];
+	nextHop = new signed char[numNodes];
+	finishDistance = new int[numNodes];
 }
 
-MazeNodeTwo* MazeLevelTwo::copyMaze(MazeNodeTwo* otherNode)
+void MazeLevelTwo::deallocateArrays()
 {
-	if (otherNode)
+	if (image.isMapped()) //The arrays are sections of the image
+		image.unmap();
+	else
 	{
-		MazeNodeTwo* newNode = new MazeNodeTwo(*otherNode);
-		for (int i = 1; i < LEVEL_TWO_NUM_DIRECTIONS; ++i)
-		{
-			MazeNodeTwo* childPtr = copyMaze(otherNode->getNextNodePtr(i));
-			newNode->setNextNodePtr(i, childPtr);
-			if (childPtr) //Connect backwards
-				childPtr->setNextNodePtr(0, newNode);
-		}
-
-		return newNode;
+		delete [] edgeOffsets;
+		delete [] edges;
+		delete [] parentEdges;
+		delete [] prizes;
+		delete [] nextHop;
+		delete [] finishDistance;
 	}
-
-	return NULL;
 }
 
-void MazeLevelTwo::buildMaze(int numNodes)
+void MazeLevelTwo::buildMaze(int maxNodes)
 {
-	Queue<MazeNodeTwo*> nodeQueue; //Use a breadth-first style build for the maze
+	allocateArrays(maxNodes); //Sized for every node we may create, trimmed once we know the final count
+	int numNodes = maxNodes; //Number of nodes that can still be created
 	int numPaths = 0;
-	int arrayIndex = 0;
+	int parentId = 0; //The next intersection to build off of, just like the front of a queue
 
-	listArray[arrayIndex++] = new MazeNodeTwo(0, LEVEL_TWO_NUM_DIRECTIONS, 0);
+	nodeCount = 1; //Create the start
+	prizes[0] = 0;
+	parentEdges[0] = -1;
+	edgeOffsets[0] = 0;
+	finishId = -1;
 	numNodes--;
 
-	nodeQueue.push(listArray[0]); //ADD LABEL
-	MazeNodeTwo* nodePtr = NULL;
+	//Cannot have the start be the finish, so we want at least one path from the start.
+	numPaths = 1 + random.nextInt(std::min(LEVEL_TWO_NUM_DIRECTIONS - 1, numNodes));
+	while (parentId < nodeCount && numNodes > 0)
+	{ //Keep building the maze until either there are no intersections left to build off of,
+		connectChildren(parentId++, numPaths, numNodes); //or we've reached the node limit.
+		numPaths = pathsFromNode(numNodes); //Generate the number of paths for the next node
+	}
 
-	while ((numPaths = pathsFromNode(numNodes)) == 0); //Cannot have the start be the finish, so we want
-	while (!nodeQueue.empty() && numNodes > 0) //at least one path from the start.
-	{ //Keep building the maze until either the Queue is empty, or we've reached the node limit.
-		nodePtr = nodeQueue.front(); //Get the next intersection
-		nodeQueue.pop();
+	if (numNodes > 0) //Premature end, so we set the last intersection built off of to be the finish.
+		finishId = parentId - 1;
 
-		MazeNodeTwo** newNodes = createNodeArray(numPaths, numNodes, nodePtr); //Generate the children
+	for (; parentId < nodeCount; ++parentId) //The remaining intersections are all dead ends
+		edgeOffsets[parentId + 1] = edgeOffsets[parentId];
 
-		if (newNodes) //If any new nodes were created
+	if (nodeCount < maxNodes) //Trim the arrays down to the nodes that were actually created
+	{
+		int* oldEdgeOffsets = edgeOffsets;
+		int* oldEdges = edges;
+		int* oldParentEdges = parentEdges;
+		signed char* oldPrizes = prizes;
+		delete [] nextHop; //The tables for reveal have not been filled yet
+		delete [] finishDistance;
+
+		allocateArrays(nodeCount);
+		for (int i = 0; i < nodeCount; ++i)
 		{
-			connectChildren(nodePtr, newNodes, numPaths); //We connect them to the current node
-			delete [] newNodes; //Deallocate the array of pointers, but NOT the nodes they point to
-
-			for (int i = 1; i < LEVEL_TWO_NUM_DIRECTIONS; ++i) //Then we put them into queue
-			{						//and store them in listArray
-				MazeNodeTwo* childNode = nodePtr->getNextNodePtr(i);
-				if (childNode)
-				{
-					listArray[arrayIndex++] = childNode;
-					nodeQueue.push(childNode);
-				}
-			}
+			edgeOffsets[i] = oldEdgeOffsets[i];
+			parentEdges[i] = oldParentEdges[i];
+			prizes[i] = oldPrizes[i];
 		}
-		numPaths = pathsFromNode(numNodes); //Generate the number of paths for the next node
+		edgeOffsets[nodeCount] = oldEdgeOffsets[nodeCount];
+		for (int i = 0; i < nodeCount - 1; ++i)
+			edges[i] = oldEdges[i];
+
+		delete [] oldEdgeOffsets;
+		delete [] oldEdges;
+		delete [] oldParentEdges;
+		delete [] oldPrizes;
 	}
-
-	if (numNodes > 0) //Premature end, so we set the last new node constructed to be the finish.
-		nodePtr->resetFinish();
 }
 
-int MazeLevelTwo::getPrizeNum() const
+int MazeLevelTwo::getPrizeNum()
 {
-	int prizeCode = rand() % LEVEL_TWO_PRIZE_DIST_SIZE; //Same syntax as MazeNodeLevelOne for generating the prize numbers for each node
+	int prizeCode = random.nextInt(LEVEL_TWO_PRIZE_DIST_SIZE); //Same syntax as MazeNodeLevelOne for generating the prize numbers for each node
 
 	if (prizeCode <= LEVEL_TWO_COIN_MAX)
 		prizeCode = 1;
@@ -152,172 +147,150 @@ int MazeLevelTwo::getPrizeNum() const
 	return prizeCode;
 }
 
-int MazeLevelTwo::pathsFromNode(int numNodes) const
-{
-	int num;
-	while ((num = (rand() % LEVEL_TWO_NUM_DIRECTIONS)) > numNodes);
-	return num; //Generate # between 0 and LEVEL_TWO_NUM_DIRECTIONS - 1 (so a # between 1 and 4 for this case)
+int MazeLevelTwo::pathsFromNode(int numNodes)
+{ //Generate # between 0 and LEVEL_TWO_NUM_DIRECTIONS - 1 (so a # between 0 and 4 for this case), or 0 and numNodes
+	return random.nextInt(std::min(LEVEL_TWO_NUM_DIRECTIONS - 1, numNodes) + 1);
 }
 
-MazeNodeTwo** MazeLevelTwo::createNodeArray(int numPaths, int& numNodes,
-						MazeNodeTwo* parentNode) const
+void MazeLevelTwo::connectChildren(int parentId, int numPaths, int& numNodes)
 {
-	if (numPaths > 0)
+	int prizeArray[4]; //Prizes of the new intersections, in the order they are created
+	int finishIndex = -1; //Index of the new intersection that is the finish, if any
+	for (int i = 0; i < numPaths; ++i)
 	{
-		MazeNodeTwo** nodeArray = new MazeNodeTwo*[numPaths]; //Create the new array of pointers
+		prizeArray[i] = getPrizeNum();
 
-		for (int i = 0; i < numPaths; nodeArray[i++] = NULL); //Assign the NULL value to them
+		if ((numNodes--) == 1) //If we reached the node limit, then set the last node to be the finish
+			finishIndex = i;
+	}
+
+	//Give the new intersections distinct random directions with a partial Fisher-Yates shuffle: after
+	//step i, pathArray[0..i] holds the directions taken so far and the rest are still available.
+	int pathArray[4] = {1, 2, 3, 4}; //Note we can have a maximum of four directions (excluding backwards)
+	int childOfPath[LEVEL_TWO_NUM_DIRECTIONS] = {-1, -1, -1, -1, -1}; //New intersection taking each direction
+	for (int i = 0; i < numPaths; ++i)
+	{
+		int swapIndex = i + random.nextInt(LEVEL_TWO_NUM_DIRECTIONS - 1 - i);
+		std::swap(pathArray[i], pathArray[swapIndex]);
+		childOfPath[pathArray[i]] = i; //The new intersection i takes this direction
+	}
 
-		for (int i = 0; i < numPaths; ++i)
+	int edgeIndex = edgeOffsets[parentId];
+	for (int pathIndex = 1; pathIndex < LEVEL_TWO_NUM_DIRECTIONS; ++pathIndex) //Append the new intersections
+	{								//in the order of their directions
+		int i = childOfPath[pathIndex];
+		if (i >= 0)
 		{
-			nodeArray[i] = new MazeNodeTwo(getPrizeNum(), LEVEL_TWO_NUM_DIRECTIONS, 0);
-			nodeArray[i]->setNextNodePtr(0, parentNode); //Connect for the backwards direction.
+			int childId = nodeCount++;
+			prizes[childId] = prizeArray[i];
+			parentEdges[childId] = (parentId << EDGE_DIRECTION_BITS) | pathIndex; //Connect backwards
+			edges[edgeIndex++] = (childId << EDGE_DIRECTION_BITS) | pathIndex;
 
-			if ((numNodes--) == 1) //If we reached the node limit, then set the last node to be the finish
-				nodeArray[i]->resetFinish();
+			if (i == finishIndex)
+				finishId = childId;
 		}
-
-		return nodeArray;
 	}
-
-	return NULL;
-
+	edgeOffsets[parentId + 1] = edgeIndex;
 }
 
-void MazeLevelTwo::connectChildren(MazeNodeTwo* parentNode, MazeNodeTwo** nodeArray, int numPaths) const
+void MazeLevelTwo::setPlayer(Player* newPlayer)
 {
-	int arrayIndex = 0;
-	int pathArray[4] = {-1, -1, -1, -1}; //Initially, none of the indices of pathPtr are connected
-	int numElements = 0; //Note we can have a maximum of four directions (excluding backwards)
-	while (arrayIndex < numPaths)
-	{
-		int pathIndex;
-		while (contains((pathIndex = (rand() % (LEVEL_TWO_NUM_DIRECTIONS - 1) + 1)),
-				pathArray, numElements)); //Get the next available pathIndex to connect
-
-		parentNode->setNextNodePtr(pathIndex, nodeArray[arrayIndex++]); //Connect the parent to its child
-		pathArray[numElements++] = pathIndex; //Update pathArray, while also incrementing numElements
-	}
+	setPlayer(ownOverlay, newPlayer);
 }
 
-bool MazeLevelTwo::contains(int pathIndex, const int pathArray[], int numElements) const
+void MazeLevelTwo::setPlayer(MazeOverlay& overlay, Player* newPlayer) const
 {
-	bool contains = false;
-	int arrayIndex = 0;
-
-	while (arrayIndex < numElements && !contains) //Check each index of pathArray
-		contains = (pathIndex == pathArray[arrayIndex++]);
-
-	return contains;
+	overlay.start(newPlayer, 0); //Put the new player at the start of the maze, with every prize in place
 }
 
-void MazeLevelTwo::setPlayer(Player* newPlayer)
+int MazeLevelTwo::movePlayer(int nextPathIndex)
 {
-	if (playerPtr) //If a player exists, we want to reset the prizes in the maze
-		resetNodes(listArray[0]);
-
-	playerPtr = newPlayer; //Put the new player at the start of the maze.
-	playerLoc = listArray[0];
+	MazeStats::Timer timer(stats, STATS_MOVE_PLAYER);
+	MoveEvent event = makeMove(nextPathIndex);
+	return printMoveEvent(event, (event.outcome == MOVE_INVALID ? "" : DIRECTION_NAMES[nextPathIndex]), ownOverlay.getPlayer());
 }
 
-int MazeLevelTwo::movePlayer(int nextPathIndex)
+inline MoveEvent MazeLevelTwo::stepPlayer(MazeOverlay& overlay, int& location, int nextPathIndex) const
 {
-	int canMove = (playerPtr && 0 <= nextPathIndex && nextPathIndex < LEVEL_TWO_NUM_DIRECTIONS);
-	if (canMove)
+	Player* playerPtr = overlay.getPlayer();
+	MoveEvent event = {MOVE_INVALID, 0, 0, -1};
+
+	if (0 <= nextPathIndex && nextPathIndex < LEVEL_TWO_NUM_DIRECTIONS)
 	{
-		if (playerLoc->getNextNodePtr(nextPathIndex)) //Valid movement
+		int nextNode = getNextNode(location, nextPathIndex);
+		if (nextNode >= 0) //Valid movement
 		{
-			canMove = 0;
-			playerLoc = playerLoc->getNextNodePtr(nextPathIndex); //Move the player
-			if (!playerLoc->isFinish()) //Player did not reach the finish
+			location = nextNode; //Move the player
+			event.prize = (overlay.isCollected(location) ? 0 : prizes[location]);
+			if (location != finishId) //Player did not reach the finish
 			{
-				switch (playerLoc->getPrizeNum()) //Check if the player won a prize
+				event.outcome = MOVE_SUCCESSFUL;
+				if (event.prize > 0) //Check if the player won a prize
 				{
-					case 1: //Player won a coin
-						std::cout << "Congratulations! You've received a coin!" << std::endl;
-						playerPtr->incrementQuantity(1);
-						std::cout << "You have " << playerPtr->getQuantity(1)
-							<< " coins." << std::endl;
-						playerLoc->resetPrize();
-						break;
-					case 2: //Player won a power
-						std::cout << "CONGRATULATIONS!! You've received a power!" << std::endl;
-						std::cout << "Activate it to reveal the next location that";
-						std::cout << " will lead you to the finish line!" << std::endl;
-						playerPtr->incrementQuantity(2);
-						std::cout << "You have " << playerPtr->getQuantity(2)
-							<< " powers to use." << std::endl;
-						playerLoc->resetPrize();
-						break;
+					playerPtr->incrementQuantity(event.prize); //Index 1 = coins, 2 = powers
+					overlay.collect(location);
 				}
-				std::cout << "Successfully moved ";
-				switch(nextPathIndex) //Tell the player which way they moved
-				{
-					case 1:
-						std::cout << "straight.";
-						break;
-					case 2:
-						std::cout << "left.";
-						break;
-					case 3:
-						std::cout << "right.";
-						break;
-					case 4:
-						std::cout << "diagonal.";
-						break;
-					default:
-						std::cout << "backwards.";
-						break;
-				}
-				std::cout << std::endl;
 			}
-			else //Finish node is reached, so we calculate the player's score.
+			else //Finish node is reached, and it may also contain a prize
 			{
-				std::cout << "CONGRATULATIONS!!! You've successfully reached the finish line!" << std::endl;
-				if (playerLoc->getPrizeNum() > 0) //Check if the finish node
-				{				//also contains a prize
-					std::cout << "AND you're lucky! You've just stumbled upon an extra ";
-					switch (playerLoc->getPrizeNum())
-					{
-						case 1:
-							std::cout << "coin!" << std::endl;
-							playerPtr->incrementQuantity(1);
-							break;
-						case 2:
-							std::cout << "power!" << std::endl;
-							playerPtr->incrementQuantity(2);
-							break;
-						default:
-							break;
-					}
-				}
-				canMove = -1;
-
+				event.outcome = MOVE_FINISH;
+				if (event.prize > 0)
+					playerPtr->incrementQuantity(event.prize);
 			}
 		}
 		else if (nextPathIndex > 0) //Dead end, > 0 accounts for the case where player moves
 					//backwards from the starting position
 		{
-			std::cout << "You've hit a dead end and lost a life!" << std::endl;
 			playerPtr->decrementQuantity(0); //Decrement the life
-
-			if (playerPtr->getQuantity(0) == 0) //Game over if the player has no lives
-				canMove = -2;
-			else //Good to go otherwise, we tell the player how many lives they have left.
-			{
-				std::cout << "You have " << playerPtr->getQuantity(0) << " lives left, ";
-				std::cout << "and are still at the same intersection." << std::endl;
-				canMove = 0;
-			}
+			event.outcome = (playerPtr->getQuantity(0) == 0 ? MOVE_GAME_OVER : MOVE_DEAD_END);
 		}
 		else //Player tries to move backwards, but they are at the start so they can't
+			event.outcome = MOVE_AT_START;
+	}
+
+	event.livesLeft = playerPtr->getQuantity(0); //Also set for an invalid path index, the player exists
+	event.nodeId = location;
+
+	return event;
+}
+
+MoveEvent MazeLevelTwo::makeMove(int nextPathIndex)
+{
+	return MazeLevelTwo::makeMove(ownOverlay, nextPathIndex); //Qualified, so that the call is not virtual
+}
+
+MoveEvent MazeLevelTwo::makeMove(MazeOverlay& overlay, int nextPathIndex) const
+{
+	stats.addCalls(STATS_MAKE_MOVE); //Counted but not timed, see MazeStats.h
+	MoveEvent event = {MOVE_INVALID, 0, 0, -1};
+	if (overlay.getPlayer()) //Move only if a player exists
+	{
+		int location = overlay.getLocation();
+		event = stepPlayer(overlay, location, nextPathIndex);
+		overlay.setLocation(location);
+	}
+
+	return event;
+}
+
+int MazeLevelTwo::makeMoves(const int* pathIndices, int numMoves, MoveEvent* events)
+{
+	int movesMade = 0;
+	if (ownOverlay.getPlayer())
+	{
+		int location = ownOverlay.getLocation(); //Kept in a local, so that it can stay in a register between the moves
+		bool gameEnded = false;
+		while (movesMade < numMoves && !gameEnded)
 		{
-			canMove = 0;
-			std::cout << "Cannot move backwards since you are already at the start!" << std::endl;
+			events[movesMade] = stepPlayer(ownOverlay, location, pathIndices[movesMade]);
+			gameEnded = (events[movesMade].outcome == MOVE_FINISH || events[movesMade].outcome == MOVE_GAME_OVER);
+			movesMade++;
 		}
+		ownOverlay.setLocation(location);
 	}
+	stats.addCalls(STATS_MAKE_MOVE, movesMade); //Once for the whole batch
 
-	return canMove;
+	return movesMade;
 }
 
 const char** MazeLevelTwo::getPossiblePaths() const //Return all the possible directions
@@ -337,32 +310,84 @@ int MazeLevelTwo::getNumPaths() const //Return the maximum possible paths for th
 	return LEVEL_TWO_NUM_DIRECTIONS;
 }
 
-bool MazeLevelTwo::findPathToFinish(MazeNodeTwo* nodePtr) const
+int MazeLevelTwo::getNodeIdLimit() const
+{
+	return nodeCount;
+}
+
+int MazeLevelTwo::writeNodeTables(int* nextNodes, int* nodeInfo) const
+{
+	for (int i = 0; i < nodeCount; ++i)
+	{
+		for (int pathIndex = 0; pathIndex < LEVEL_TWO_NUM_DIRECTIONS; ++pathIndex)
+			nextNodes[i * LEVEL_TWO_NUM_DIRECTIONS + pathIndex] = getNextNode(i, pathIndex);
+		nodeInfo[i] = prizes[i] + (i == finishId ? NODE_TABLE_FINISH : 0);
+	}
+
+	return 0; //The start
+}
+
+int MazeLevelTwo::getNextNode(int nodeId, int pathIndex) const
+{
+	if (pathIndex == 0) //Backwards, the start has no parent
+		return (parentEdges[nodeId] < 0 ? -1 : parentEdges[nodeId] >> EDGE_DIRECTION_BITS);
+
+	for (int i = edgeOffsets[nodeId]; i < edgeOffsets[nodeId + 1]; ++i) //At most four edges to look at
+	{
+		if ((edges[i] & EDGE_DIRECTION_MASK) == pathIndex)
+			return edges[i] >> EDGE_DIRECTION_BITS;
+	}
+
+	return -1; //Dead end
+}
+
+void MazeLevelTwo::computeFinishTable()
 {
-	if (nodePtr)
+	int* searchOrder = new int[nodeCount]; //IDs in the order they are reached, read from the front
+	int front = 0;				//like a queue
+	int back = 0;
+
+	for (int i = 0; i < nodeCount; finishDistance[i++] = -1); //-1 = not reached yet
+	finishDistance[finishId] = 0; //Start the search at the finish
+	nextHop[finishId] = 0; //Nowhere left to go, report backwards
+	searchOrder[back++] = finishId;
+
+	while (front < back)
 	{
-		int nextPathIndex = 1;
-		bool isFinish = (nodePtr->isFinish()); //If curent node is the finish, we are done.
-		while (!isFinish && nextPathIndex < LEVEL_TWO_NUM_DIRECTIONS) //Otherwise, check its adjacent
-			isFinish = findPathToFinish(nodePtr->getNextNodePtr(nextPathIndex++)); //nodes
+		int nodeId = searchOrder[front++];
+
+		int parentEdge = parentEdges[nodeId];
+		if (parentEdge >= 0 && finishDistance[parentEdge >> EDGE_DIRECTION_BITS] < 0) //The parent reaches
+		{								//nodeId through the direction of the edge
+			int parentId = parentEdge >> EDGE_DIRECTION_BITS;
+			finishDistance[parentId] = finishDistance[nodeId] + 1;
+			nextHop[parentId] = parentEdge & EDGE_DIRECTION_MASK;
+			searchOrder[back++] = parentId;
+		}
 
-		return isFinish; //Returns true if path does not exist, false otherwise
+		for (int i = edgeOffsets[nodeId]; i < edgeOffsets[nodeId + 1]; ++i) //The children go backwards
+		{									//to reach nodeId
+			int childId = edges[i] >> EDGE_DIRECTION_BITS;
+			if (finishDistance[childId] < 0)
+			{
+				finishDistance[childId] = finishDistance[nodeId] + 1;
+				nextHop[childId] = 0;
+				searchOrder[back++] = childId;
+			}
+		}
 	}
-	return false; //Occurs if we've reached a dead end
+
+	delete [] searchOrder;
 }
 
 bool MazeLevelTwo::reveal() const
 {
-	bool canReveal = (playerPtr && playerPtr->getQuantity(2) > 0); //We can only reveal
-	if (canReveal) //if there is a player in the maze, and that player has at least one power to use
+	MazeStats::Timer timer(stats, STATS_REVEAL);
+	int pathIndex = revealPath();
+	if (pathIndex >= 0) //if there is a player in the maze, and that player had at least one power to use
 	{
-		int pathIndex = 1;
-		playerPtr->decrementQuantity(2); //Reduce the available powers by one
 		std::cout << "Consuming your power..." << std::endl;
 
-		for (; pathIndex < LEVEL_TWO_NUM_DIRECTIONS && //Check if path exists for all its children
-			!findPathToFinish(playerLoc->getNextNodePtr(pathIndex)); ++pathIndex);
-
 		switch (pathIndex) //Tell user which direction to go to reach the finish
 		{
 			case 1: //pathIndex of 1 means we go straight
@@ -381,15 +406,44 @@ bool MazeLevelTwo::reveal() const
 				std::cout << "Go backwards to get to the maze exit!" << std::endl;
 				break;
 		}
+		std::cout << "The exit is " << getDistanceToFinish() << " intersection(s) away." << std::endl;
 	}
 	else //No powers to consume
 		std::cout << "You have no power to use!" << std::endl;
 
-	return canReveal;
+	return (pathIndex >= 0);
+}
+
+int MazeLevelTwo::revealPath() const
+{
+	return revealPath(ownOverlay);
+}
+
+int MazeLevelTwo::revealPath(const MazeOverlay& overlay) const
+{
+	stats.addCalls(STATS_REVEAL_PATH);
+	Player* playerPtr = overlay.getPlayer();
+	if (!playerPtr || !playerPtr->decrementQuantity(2)) //We can only reveal if there is a player in the maze,
+		return -1;					//and that player has at least one power to use
+
+	int pathIndex = nextHop[overlay.getLocation()]; //Precomputed when the maze was built
+	if (pathIndex < 1 || pathIndex >= LEVEL_TWO_NUM_DIRECTIONS) //None of the next intersections reach the finish,
+		pathIndex = 0; //so we go backwards
+
+	return pathIndex;
+}
+
+int MazeLevelTwo::getDistanceToFinish() const
+{
+	if (ownOverlay.getPlayer())
+		return finishDistance[ownOverlay.getLocation()];
+	else //Dummy value if there is no player
+		return -1;
 }
 
 int MazeLevelTwo::calcScore() const
 {
+	Player* playerPtr = ownOverlay.getPlayer();
 	if (playerPtr) //Calculate the score only if a player exists in the maze
 	{
 		int score = 0;
@@ -406,47 +460,165 @@ int MazeLevelTwo::calcScore() const
 		return -1;
 }
 
-void MazeLevelTwo::resetNodes(MazeNodeTwo* nodePtr) //Pre-order reset of the nodes
+void MazeLevelTwo::startOver() //Reset the maze
+{
+	startOver(ownOverlay);
+}
+
+void MazeLevelTwo::startOver(MazeOverlay& overlay) const
 {
-	if (nodePtr)
+	MazeStats::Timer timer(stats, STATS_START_OVER);
+	if (overlay.getPlayer())
 	{
-		nodePtr->resetPrize(); //Reset current node first, then all of its adjacent nodes
-		for (int i = 1; i < LEVEL_TWO_NUM_DIRECTIONS; ++i)
-			resetNodes(nodePtr->getNextNodePtr(i));
+		overlay.setLocation(0);
+		overlay.getPlayer()->resetNumItems();
 	}
+	overlay.resetCollected(); //Puts back the prizes collected since the last reset
 }
 
-void MazeLevelTwo::startOver() //Reset the maze
+void MazeLevelTwo::readShape(MazeStatsReport& report) const
 {
-	if (playerPtr)
+	report.level = 2;
+	report.nodesAllocated = nodeCount;
+	report.bytesUsed = getBytesUsed();
+	report.depth = 0;
+	for (int nodeId = nodeCount - 1; nodeId != 0; nodeId = parentEdges[nodeId] >> EDGE_DIRECTION_BITS)
+		report.depth++;
+
+	report.deadEnds = report.coins = report.powers = 0;
+	for (int i = 0; i < nodeCount; ++i)
 	{
-		playerLoc = listArray[0];
-		playerPtr->resetNumItems();
+		if (i != finishId) //The player stops at the finish
+			report.deadEnds += LEVEL_TWO_NUM_DIRECTIONS - 1 - (edgeOffsets[i + 1] - edgeOffsets[i]);
+
+		report.coins += (prizes[i] == 1);
+		report.powers += (prizes[i] == 2);
 	}
-	resetNodes(listArray[0]);
 }
 
-void MazeLevelTwo::displayMaze() const //Display the information in listArray
+uint64_t MazeLevelTwo::getSeed() const
+{
+	return random.getSeed();
+}
+
+size_t MazeLevelTwo::getBytesUsed() const
+{
+	return (nodeCount + 1) * sizeof(int) //edgeOffsets
+		+ (nodeCount - 1) * sizeof(int) //edges
+		+ nodeCount * (2 * sizeof(int) + 2 * sizeof(signed char)); //parentEdges, finishDistance, prizes
+}										//and nextHop
+
+bool MazeLevelTwo::save(const char* fileName) const
+{
+	MazeImage newImage;
+	bool saved = (newImage.create(fileName, 2, 0, nodeCount, 0, finishId, random.getSeed())
+		&& newImage.writeSection(0, edgeOffsets, (nodeCount + 1) * sizeof(int))
+		&& newImage.writeSection(1, edges, (nodeCount - 1) * sizeof(int))
+		&& newImage.writeSection(2, parentEdges, nodeCount * sizeof(int))
+		&& newImage.writeSection(3, prizes, nodeCount * sizeof(signed char))
+		&& newImage.writeSection(4, nextHop, nodeCount * sizeof(signed char))
+		&& newImage.writeSection(5, finishDistance, nodeCount * sizeof(int)));
+
+	return newImage.finish() && saved;
+}
+
+/*
+Returns true if the arrays of a maze image hold a maze of numNodes intersections: the rows of edgeOffsets
+cover edges in order, every edge leads to a later intersection in a valid direction, the rows are sorted
+by direction, every intersection but the start is reached by exactly one edge, which parentEdges holds,
+and the prizes and the tables of the finish are in range. Each entry is read once, so this takes O(n).
+*/
+static bool checkArrays(int numNodes, const int* edgeOffsets, const int* edges, const int* parentEdges,
+		const signed char* prizes, const signed char* nextHop, const int* finishDistance)
+{
+	if (edgeOffsets[0] != 0 || edgeOffsets[numNodes] != numNodes - 1 || parentEdges[0] != -1)
+		return false;
+
+	for (int nodeId = 0; nodeId < numNodes; ++nodeId)
+	{
+		if (edgeOffsets[nodeId + 1] < edgeOffsets[nodeId] || edgeOffsets[nodeId + 1] > numNodes - 1
+			|| prizes[nodeId] < 0 || prizes[nodeId] > 2 || nextHop[nodeId] < 0
+			|| nextHop[nodeId] >= LEVEL_TWO_NUM_DIRECTIONS || finishDistance[nodeId] < 0)
+			return false;
+
+		int lastDirection = 0; //Backwards, which is never an edge
+		for (int i = edgeOffsets[nodeId]; i < edgeOffsets[nodeId + 1]; ++i)
+		{
+			int childId = edges[i] >> EDGE_DIRECTION_BITS;
+			int direction = edges[i] & EDGE_DIRECTION_MASK;
+			if (childId <= nodeId || childId >= numNodes || direction <= lastDirection
+				|| direction >= LEVEL_TWO_NUM_DIRECTIONS || parentEdges[childId] != ((nodeId << EDGE_DIRECTION_BITS) | direction))
+				return false;
+			lastDirection = direction;
+		}
+	}
+
+	return true; //The numNodes - 1 edges lead to distinct intersections, each having a single parent
+}
+
+bool MazeLevelTwo::load(const char* fileName)
+{
+	stats.startGeneration(); //Only finished if the image is loaded
+	MazeImage newImage;
+	if (!newImage.map(fileName, 2))
+		return false;
+
+	uint64_t numNodes = newImage.getHeader().nodeCount;
+	int* newEdgeOffsets = reinterpret_cast<int*>(newImage.getSection(0, (numNodes + 1) * sizeof(int)));
+	int* newEdges = reinterpret_cast<int*>(newImage.getSection(1, (numNodes - 1) * sizeof(int)));
+	int* newParentEdges = reinterpret_cast<int*>(newImage.getSection(2, numNodes * sizeof(int)));
+	signed char* newPrizes = reinterpret_cast<signed char*>(newImage.getSection(3, numNodes * sizeof(signed char)));
+	signed char* newNextHop = reinterpret_cast<signed char*>(newImage.getSection(4, numNodes * sizeof(signed char)));
+	int* newFinishDistance = reinterpret_cast<int*>(newImage.getSection(5, numNodes * sizeof(int)));
+
+	bool isValid = (numNodes >= 2 && numNodes <= uint64_t(MAX_LEVEL_TWO_NODE_NUM) && newImage.getHeader().finishId < numNodes
+		&& newEdgeOffsets && newEdges && newParentEdges && newPrizes && newNextHop && newFinishDistance
+		&& checkArrays(int(numNodes), newEdgeOffsets, newEdges, newParentEdges, newPrizes, newNextHop, newFinishDistance));
+
+	if (isValid)
+	{
+		deallocateArrays(); //Frees the previous arrays, or unmaps the previous image
+		image.swap(newImage);
+
+		nodeCount = numNodes;
+		finishId = image.getHeader().finishId;
+		random.setSeed(image.getHeader().seed);
+		edgeOffsets = newEdgeOffsets;
+		edges = newEdges;
+		parentEdges = newParentEdges;
+		prizes = newPrizes;
+		nextHop = newNextHop;
+		finishDistance = newFinishDistance;
+		ownOverlay.start(ownOverlay.getPlayer(), 0); //Back to the start, like startOver
+		if (ownOverlay.getPlayer())
+			ownOverlay.getPlayer()->resetNumItems();
+		stats.finishGeneration();
+	}
+
+	return isValid;
+}
+
+void MazeLevelTwo::displayMaze() const //Display the maze one row of edges at a time
 {
 	std::cout << "   S L R D" << std::endl; //S = Straight, L = Left, R = Right, D = Diagonal
-	for (int i = 0; i < arraySize && listArray[i]; ++i)
+	for (int i = 0; i < nodeCount; ++i)
 	{
-		MazeNodeTwo* currentNode = listArray[i]; //Get the next node to visit
-		if (!currentNode->isFinish()) //If node isn't the finish
+		if (i != finishId) //If node isn't the finish
 		{
-			if (playerLoc == currentNode)
+			if (ownOverlay.getLocation() == i)
 				std::cout << "P  ";
 			else
 				std::cout << "O  ";
 
-			for (int i = 1; i < LEVEL_TWO_NUM_DIRECTIONS; ++i)
-			{ //This loop puts all of the non-dead end or NULL adjacent nodes into the queue to
-				MazeNodeTwo* nextNode = currentNode->getNextNodePtr(i); //visit next
-				if (nextNode) //Not a dead-end, so we put it into the queue for display
-				{
-					if (!nextNode->isFinish())
+			int edgeIndex = edgeOffsets[i];
+			for (int pathIndex = 1; pathIndex < LEVEL_TWO_NUM_DIRECTIONS; ++pathIndex)
+			{ //The row is sorted by direction, so each edge is looked at once
+				if (edgeIndex < edgeOffsets[i + 1] && (edges[edgeIndex] & EDGE_DIRECTION_MASK) == pathIndex)
+				{ //Not a dead-end
+					int nextNode = edges[edgeIndex++] >> EDGE_DIRECTION_BITS;
+					if (nextNode != finishId)
 					{
-						if (playerLoc == nextNode)
+						if (ownOverlay.getLocation() == nextNode)
 							std::cout << "P ";
 						else
 							std::cout << "O ";
@@ -467,17 +639,3 @@ void MazeLevelTwo::displayMaze() const //Display the information in listArray
 		std::cout << std::endl;
 	}
 }
-
-
-
-
-
-
-
-
-
-
-
-
-
-
@@ -2,24 +2,37 @@
 #define _MAZE_LEVEL_TWO_H
 
 /*
-This is the class that implements Level 2 of the maze. It is derived from MazeInterface. A specialized
-adjacency list is used to implement the nodes in the maze.
+This is the class that implements Level 2 of the maze. It is derived from MazeInterface. The maze is
+stored in compressed sparse row (CSR) form: the intersections are numbered in breadth-first order,
+and the paths leading out of intersection i are edges[edgeOffsets[i]] to edges[edgeOffsets[i + 1] - 1].
+Each edge packs the direction of the path together with the intersection it leads to, and the prize of
+every intersection is kept in an array parallel to the intersections. Since the rows are laid out in the
+same breadth-first order the maze is built and displayed in, walking the maze reads the arrays
+sequentially, and an intersection costs a few bytes rather than a node holding five pointers.
 
 For Level 2, there are five possible directions the user can take:
 B = Backwards, S = Straight, L = Left, R = Right, and D = Diagonal.
 */
 
 
+#include "MazeImage.h"
 #include "MazeInterface.h"
-#include "MazeNodeTwo.h"
-#include "Queue.h"
+#include "MazeRandom.h"
+#include "Stack.h"
 
+#include <climits>
+#include <cstddef>
 #include <cstdlib>
 
 const int DEFAULT_LEVEL_TWO_NODE_NUM = 10; //Default number of nodes in level 1 of the maze
 const int LEVEL_TWO_NUM_DIRECTIONS = 5; //Number of possible paths that the player can take,
 //for the present project, index 0 = backwards, 1 = straight, 2 = left, 3 = right, and 4 = diagonal
 
+//An edge is stored as (target << EDGE_DIRECTION_BITS) | direction
+const int EDGE_DIRECTION_BITS = 3;
+const int EDGE_DIRECTION_MASK = (1 << EDGE_DIRECTION_BITS) - 1;
+const int MAX_LEVEL_TWO_NODE_NUM = INT_MAX >> EDGE_DIRECTION_BITS; //Most nodes whose IDs fit in an edge
+
 /*
 These variables store how the prizes in level 2 will be distributd.
 Coins occur with a 1/3 change for all levels, but the encounter of a power
@@ -32,14 +45,27 @@ const int LEVEL_TWO_COIN_MAX = (LEVEL_TWO_PRIZE_DIST_SIZE - 1)/3;
 class MazeLevelTwo : public MazeInterface
 {
 public:
-	//Constructor, takes the number of nodes in the maze (i.e. valid intersections) as input
+	//Constructor, takes the number of nodes in the maze (i.e. valid intersections) as input, at most
+	//MAX_LEVEL_TWO_NODE_NUM, to which larger numbers are clamped.
+	//The maze is generated from a seed drawn from rand() (see MazeRandom::makeSeed).
 	MazeLevelTwo(int numNodes = DEFAULT_LEVEL_TWO_NODE_NUM);
+
+	//Same as above, but the maze is generated from seed, so the same arguments always give the same maze.
+	MazeLevelTwo(int numNodes, uint64_t seed);
 	MazeLevelTwo(const MazeLevelTwo&); //Copy constructor
 	~MazeLevelTwo(); //Destructor
 
 	void setPlayer(Player* newPlayer); //Described in maze interface
+	void setPlayer(MazeOverlay& overlay, Player* newPlayer) const; //Described in maze interface
 	int movePlayer(int nextPathIndex); //Described in maze interface
 
+	/*
+	Described in maze interface. The ID of a node is its breadth-first number, 0 being the start.
+	*/
+	MoveEvent makeMove(int nextPathIndex);
+	MoveEvent makeMove(MazeOverlay& overlay, int nextPathIndex) const;
+	int makeMoves(const int* pathIndices, int numMoves, MoveEvent* events); //Described in maze interface
+
 	/*
 	Described in maze interface. Here, a pointer, call it ptr, is returned having the following strings
 	at its indices:
@@ -53,9 +79,14 @@ public:
 	*/
 	const char** getPossiblePaths() const;
 	int getNumPaths() const; //Described in maze interface
+	int getNodeIdLimit() const; //Described in maze interface
+	int writeNodeTables(int* nextNodes, int* nodeInfo) const; //Described in maze interface
 	bool reveal() const; //Described in maze interface
+	int revealPath() const; //Described in maze interface
+	int revealPath(const MazeOverlay& overlay) const; //Described in maze interface
 	int calcScore() const; //Described in maze interface
 	void startOver(); //Described in maze interface
+	void startOver(MazeOverlay& overlay) const; //Described in maze interface
 
 	/*
 	Outputs the tree in an adjacency list style with a breadth first traversal.
@@ -73,14 +104,69 @@ public:
 	*/
 	void displayMaze() const;
 
+	/*
+	Returns the number of bytes used by the arrays storing the maze, including the tables used by reveal.
+	*/
+	size_t getBytesUsed() const;
+
+	/*
+	Returns the seed the maze was generated from. Passing it back to the constructor, along with the
+	same number of nodes, rebuilds the same maze.
+	*/
+	uint64_t getSeed() const;
+
+	/*
+	Returns the number of intersections between the player and the maze exit, e.g. so that the client
+	can show "N intersections to the exit". Like reveal, this is a lookup in the table computed when
+	the maze was built.
+	@return: The distance to the finish, 0 if the player is on it, or -1 if there is no player.
+	*/
+	int getDistanceToFinish() const;
+
+	/*
+	Saves the maze into a maze image (see MazeImage), so that it can be loaded again without rebuilding it.
+	The sections of the image are the arrays of the maze, in the order edgeOffsets, edges, parentEdges,
+	prizes, nextHop and finishDistance, and the header holds the ID of the finish.
+	@return: True if the image was written, false otherwise.
+	*/
+	bool save(const char* fileName) const;
+
+	/*
+	Replaces the maze with the one saved in fileName. The image is mapped into memory, its arrays are
+	checked to hold a maze, in O(n), and the arrays of the maze then point straight into it. If there is
+	a player, they are moved to the start and their collectibles are reset, as in startOver.
+	@return: True if the maze was loaded. False if the file is not a Level 2 image written by this
+	version of the program, or its arrays do not hold a maze, in which case the maze is left as it was. The overlays other than the one
+	owned by the maze must be started again with setPlayer before they are played in the new maze.
+	*/
+	bool load(const char* fileName);
+
+protected:
+	/*
+	Described in maze interface. Since the intersections are numbered breadth first, the last one is
+	the deepest, and its depth is found by walking parentEdges up to the start.
+	*/
+	void readShape(MazeStatsReport& report) const;
+
 private:
-	Player* playerPtr; //Pointer to store the player
-	MazeNodeTwo* playerLoc; //Pointer to store the player's location in the maze
-	MazeNodeTwo** listArray; //Array to store the nodes in the maze
-	int arraySize; //Variable to store the size of the list array
+	MazeRandom random; //Generates the shape and the prizes of the maze
+	MazeOverlay ownOverlay; //Game played by the functions that take no overlay
+	int nodeCount; //Number of intersections in the maze. The start is intersection 0
+	int finishId; //ID of the maze exit
+
+	int* edgeOffsets; //nodeCount + 1 entries, row i of edges is [edgeOffsets[i], edgeOffsets[i + 1])
+	int* edges; //nodeCount - 1 packed edges, each row sorted by direction
+	int* parentEdges; //Packed edge leading to each intersection from its parent, -1 for the start
+
+	//The tables below are parallel to the intersections, and are indexed by their IDs.
+	signed char* prizes; //Prize code of each intersection, the games keep track of the ones they collected
+	signed char* nextHop; //Direction to take from each node to get closer to the finish
+	int* finishDistance; //Number of intersections between each node and the finish
+
+	MazeImage image; //Image the arrays point into if the maze was loaded, in which case they are not freed
 
 	/*
-	Builds a maze having a maximum number of nodes specified by numNodes, excluding the starting
+	Builds a maze having a maximum number of nodes specified by maxNodes, excluding the starting
 	location. The last node of the maze is the finish. Uses a "breadth-first" style build-up,
 	where the number of directions each intersection will have is randomly assigned and randomly
 	allocated and that the first intersection created is the next intersection that will be considered
@@ -88,98 +174,81 @@ private:
 	is the next node that will have a breadth-first traversal in a breadth-first style traversal
 	of a graph.
 
-	@para numNodes: The number of nodes the maze will have
-	@post: A maze having a maximum of numNodes + 1 nodes (+1 is for the starting location) is created,
-	but the final node count could be less due to the random allocation of directions.
+	Since the intersections are numbered in the order they are created, the next intersection to build
+	off of is always the next ID, so no queue is needed and each row of edges is written exactly once.
+
+	@para maxNodes: The number of nodes the maze will have
+	@post: A maze having a maximum of maxNodes + 1 nodes (+1 is for the starting location) is created,
+	but the final node count could be less due to the random allocation of directions. The arrays are
+	trimmed down to the final node count.
 	*/
-	void buildMaze(int numNodes); //Build the maze using a queue.
+	void buildMaze(int maxNodes); //Build the maze in breadth-first order.
 
 	/*
 	Returns either 0, 1 or 2 to designate the prize number. Used when creatig a new node.
 	Recall that 0 = the node has no prize, 1 = it has a coin, and 2 = it has a power.
 	*/
-	int getPrizeNum() const;
+	int getPrizeNum();
 
 	/*
 	Function returns the number of intersections (i.e. non-dead end paths) that the current intersection
 	will be connected to/have. A maximum of 4 intersections is possible, as the fifth direction is
-	"backwards" which is already accounted for.
+	"backwards" which is already accounted for. The number is drawn directly from the allowed range,
+	so no draws are thrown away.
 	@param: numNodes - The remaining number of nodes that can be created.
 	@return: A value between 0 and 4, or 0 and numNodes.
 	*/
-	int pathsFromNode(int numNodes) const;
-
-	/*
-	Returns an array of pointers that contain the next set of intersections that will be connected
-	to the maze, and also connects these new pointers to the current intersection (to establish their
-	"backwards" direction).
-
-	@param: numPaths - The number of paths from the intersection
-	numNodes - The number of nodes remaining that can be made. If numNodes drops to 1 in createNodeArray,
-	then the corresponding new node is set to be the finish.
-	parentNode - A pointer to the current intersection in order to connect the new, created nodes
-	to their "parent" [to establish the backwards direction]
-
-	@post: numNodes will be decremented by an amount equivalent to numPaths
-	and an array of node pointers will be returned containing the next intersections
-	to be connected. Also, these new pointers will be connected to their parent, parentNode.
-	*/
-	MazeNodeTwo** createNodeArray(int numPaths, int& numNodes,
-							MazeNodeTwo* parentNode) const;
+	int pathsFromNode(int numNodes);
 
 	/*
-	Function randomly connects the new nodes contained in nodeArray to the parent, where these nodes
-	will serve as either the straight, left, right, or diagonal directions of the parent with the
-	corresponding direction chosen randomly. After being connected, these nodes will then be placed into
-	the nodeQueue.
-
-	@param: nodeQueue - The queue containing the next set of intersections/nodes to build more
-	intersections/nodes off of.
-	parentNode - Pointer to the current intersection, used to connect its children to itself.
-	nodeArray - Array of pointeres storing the next set of intersections to be created
-	numPaths - The number of new nodes/intersections to be connected
-
-	@post: parentNode has numPaths children connected to it, where the corresponding pointer
-	is chosen randomly for each pointer in nodeArray. Finally, these same numPaths pointers are placed
-	in nodeQueue to further build the maze, if necessary.
+	Creates the numPaths children of the intersection parentId, giving each of them a random prize and
+	a random direction out of parentId, then appends them to the maze in the order of their directions.
+	The directions are picked with a partial Fisher-Yates shuffle of the four forward directions, so
+	this does a constant amount of work.
+
+	@param: parentId - ID of the current intersection, whose row of edges is written.
+	numPaths - The number of paths from the intersection
+	numNodes - The number of nodes remaining that can be made. If numNodes drops to 1, then the
+	corresponding new node is set to be the finish.
+
+	@post: numNodes will be decremented by an amount equivalent to numPaths, the children are given the
+	next free IDs and the row of parentId is complete.
 	*/
-	void connectChildren(MazeNodeTwo* parentNode, MazeNodeTwo** nodeArray, int numPaths) const;
+	void connectChildren(int parentId, int numPaths, int& numNodes);
 
 	/*
-	Function checks if the corresponding "pathIndex" child pointer of parentNode from above
-	has already been connected.
-
-	@param: pathIndex - The index of pathPtr to be checked
-	pathArray[] - An array storing the indices of pathPtr that have been connected
-	numElements - Number of elements to examine in pathArray
-
-	@return: True if pathIndex is in pathArray, false otherwise.
+	Returns the ID of the intersection reached by taking direction pathIndex from nodeId, or -1 if
+	it is a dead end. The backwards direction is looked up in parentEdges, the others in the row of nodeId.
 	*/
-	bool contains(int pathIndex, const int pathArray[], int numElements) const;
-
+	int getNextNode(int nodeId, int pathIndex) const;
 
 	/*
-	Recursive copy function, used with the copy constructor.
+	Moves the player of overlay, who must exist, from location towards nextPathIndex. Used by makeMove
+	and makeMoves, which pass a local copy of the location of the overlay.
+	@post: location is the player's location after the move, and the prize collected, if any, is
+	marked in overlay.
+	@return: The result of the move, see MazeInterface::makeMove.
 	*/
-	MazeNodeTwo* copyMaze(MazeNodeTwo* otherNode);
+	MoveEvent stepPlayer(MazeOverlay& overlay, int& location, int nextPathIndex) const;
 
 	/*
-	Function that resets the prizeNum of each node in the maze. Used in conjunction with startOver.
-	@param: nodePtr - Pointer to the current intersection to be resetted
-	@post: All the prizes in the maze are resetted.
+	Allocates the arrays of the maze for numNodes intersections. The contents are left uninitialized.
 	*/
-	void resetNodes(MazeNodeTwo* nodePtr);
+	void allocateArrays(int numNodes);
 
 	/*
-	Checks if a path to the maze exit exists starting at nodePtr
-	@return: True if a path does exist, false otherwise.
+	Deallocates the arrays of the maze, or unmaps the image they point into.
 	*/
-	bool findPathToFinish(MazeNodeTwo* nodePtr) const;
+	void deallocateArrays();
 
 	/*
-	Deletes the entire maze
+	Fills nextHop and finishDistance with a single breadth-first search that starts at the finish.
+	When a node is first reached from one of its neighbours, that neighbour is one step closer to
+	the finish, so the direction leading to it is the node's next hop. The search order is recorded
+	in an array of IDs, which doubles as the queue.
+	@post: nextHop and finishDistance are filled in for every node of the maze.
 	*/
-	void removeAll();
+	void computeFinishTable();
 
 };
 
@@ -0,0 +1,44 @@
+/*
+This is the implementation file corresponding to MazeLibrary.h containing the definitions of the member functions.
+*/
+
+#include "MazeLibrary.h"
+
+MazeLibrary::MazeLibrary(int levelOneNodes, int levelTwoNodes, int numMazes, bool balancedLevelOne)
+	: numMazes(numMazes > 0 ? numMazes : 1), nextMaze(0)
+{
+	levelOneMazes = new MazeLevelOne*[this->numMazes];
+	levelTwoMazes = new MazeLevelTwo*[this->numMazes];
+	for (int i = 0; i < this->numMazes; ++i)
+	{
+		levelOneMazes[i] = new MazeLevelOne(levelOneNodes, balancedLevelOne);
+		levelTwoMazes[i] = new MazeLevelTwo(levelTwoNodes);
+	}
+}
+
+MazeLibrary::~MazeLibrary()
+{
+	for (int i = 0; i < numMazes; ++i)
+	{
+		delete levelOneMazes[i];
+		delete levelTwoMazes[i];
+	}
+	delete [] levelOneMazes;
+	delete [] levelTwoMazes;
+}
+
+const MazeInterface* MazeLibrary::getMaze(int level)
+{
+	int mazeIndex = nextMaze.fetch_add(1, std::memory_order_relaxed) % numMazes;
+	if (level == 1)
+		return levelOneMazes[mazeIndex];
+	else if (level == 2)
+		return levelTwoMazes[mazeIndex];
+	else
+		return NULL;
+}
+
+int MazeLibrary::getNumMazes() const
+{
+	return numMazes;
+}
@@ -0,0 +1,54 @@
+#ifndef _MAZE_LIBRARY_H
+#define _MAZE_LIBRARY_H
+
+/*
+This is the class holding the mazes shared by the sessions of MazeServer. A few mazes of each level are
+built once, when the library is created, and every session that asks for a new maze is given one of
+them, in turn, which it plays through its own MazeOverlay. The mazes are never copied, so thousands of
+sessions can play the same large maze while the server only stores it once.
+
+The library is only read after it is built, so it can be used from any number of threads.
+*/
+
+#include "MazeInterface.h"
+#include "MazeLevelOne.h"
+#include "MazeLevelTwo.h"
+
+#include <atomic>
+
+const int DEFAULT_LIBRARY_MAZES = 4; //Mazes built for each level
+
+class MazeLibrary
+{
+public:
+	/*
+	Builds numMazes mazes of each level, from seeds drawn from rand() (see MazeRandom::makeSeed).
+	@param levelOneNodes, levelTwoNodes: The number of nodes of the mazes of each level.
+	numMazes: The number of mazes built for each level, at least 1.
+	balancedLevelOne: If true, the Level 1 mazes are built balanced (see MazeLevelOne).
+	*/
+	MazeLibrary(int levelOneNodes, int levelTwoNodes, int numMazes = DEFAULT_LIBRARY_MAZES,
+			bool balancedLevelOne = false);
+	~MazeLibrary();
+
+	/*
+	Returns the next maze of the given level. It is owned by the library and shared with the other
+	callers, so it must only be played through the functions of MazeInterface that take an overlay.
+	@param level: 1 for Level 1, 2 for Level 2.
+	@return: The maze, or NULL if level is neither 1 nor 2.
+	*/
+	const MazeInterface* getMaze(int level);
+
+	int getNumMazes() const; //Returns the number of mazes of each level
+
+private:
+	int numMazes; //Number of mazes of each level
+	MazeLevelOne** levelOneMazes; //The mazes that are shared, numMazes of each level
+	MazeLevelTwo** levelTwoMazes;
+	std::atomic<unsigned int> nextMaze; //Counts the mazes given out, to go through them in turn
+
+	MazeLibrary(const MazeLibrary&); //The library owns its mazes, so it cannot be copied
+	MazeLibrary& operator=(const MazeLibrary&);
+};
+
+#endif
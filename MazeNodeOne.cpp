@@ -4,13 +4,55 @@
 This is the implementation file for MazeNodeOne.h containing the definitions of the member functions.
 */
 
-MazeNodeOne::MazeNodeOne(int prizeCode, int pathNum, bool isFinish, int key)
-	: MazeNode<MazeNodeOne*>(prizeCode, pathNum, isFinish), sortKey(key)
+MazeNodeOne::MazeNodeOne(int prizeCode, bool isFinish, int key, int nodePriority)
+	: sortKey(key), priority(nodePriority), nodeIndex(NULL_NODE_INDEX),
+		flags(uint8_t((prizeCode & NODE_ONE_PRIZE_MASK) | (isFinish ? NODE_ONE_FINISH : 0)))
 {
+	for (int i = 0; i < NODE_ONE_NUM_PATHS; ++i) //Every path starts as a dead end
+		links[i] = NULL_NODE_INDEX;
+	reserved[0] = reserved[1] = reserved[2] = 0;
 }
 
-MazeNodeOne::~MazeNodeOne()
+MazeNodeOne::MazeNodeOne(const MazeNodeOne& otherNode)
+	: sortKey(otherNode.sortKey), priority(otherNode.priority), nodeIndex(NULL_NODE_INDEX),
+		flags(otherNode.flags)
 {
+	for (int i = 0; i < NODE_ONE_NUM_PATHS; ++i) //We only want the node's contents, not its children.
+		links[i] = NULL_NODE_INDEX;
+	reserved[0] = reserved[1] = reserved[2] = 0;
+}
+
+int MazeNodeOne::getPrizeNum() const
+{
+	return flags & NODE_ONE_PRIZE_MASK;
+}
+
+bool MazeNodeOne::isFinish() const
+{
+	return (flags & NODE_ONE_FINISH) != 0;
+}
+
+int MazeNodeOne::getNumPaths() const
+{
+	return NODE_ONE_NUM_PATHS;
+}
+
+uint32_t MazeNodeOne::getNextNodePtr(int pathIndex) const
+{
+	if (0 <= pathIndex && pathIndex < NODE_ONE_NUM_PATHS) //Check if pathIndex is within the bounds
+		return links[pathIndex];
+	else //Return a dead end if it isn't.
+		return NULL_NODE_INDEX;
+}
+
+bool MazeNodeOne::setNextNodePtr(int pathIndex, uint32_t nextNode)
+{
+	bool canSet = (0 <= pathIndex && pathIndex < NODE_ONE_NUM_PATHS); //Checking array bounds
+
+	if (canSet) //Setting the value of links[pathIndex] to nextNode if canSet is true
+		links[pathIndex] = nextNode;
+
+	return canSet;
 }
 
 int MazeNodeOne::getSortKey() const
@@ -18,14 +60,42 @@ int MazeNodeOne::getSortKey() const
 	return sortKey;
 }
 
+int MazeNodeOne::getPriority() const
+{
+	return priority;
+}
+
+bool MazeNodeOne::isOnFinishPath() const
+{
+	return (flags & NODE_ONE_ON_FINISH_PATH) != 0;
+}
+
+void MazeNodeOne::setOnFinishPath(bool onPath)
+{
+	flags = uint8_t(onPath ? flags | NODE_ONE_ON_FINISH_PATH : flags & ~NODE_ONE_ON_FINISH_PATH);
+}
+
+uint8_t MazeNodeOne::getFlags() const
+{
+	return flags;
+}
+
+uint32_t MazeNodeOne::getNodeIndex() const
+{
+	return nodeIndex;
+}
+
+void MazeNodeOne::setNodeIndex(uint32_t index)
+{
+	nodeIndex = index;
+}
+
 const MazeNodeOne& MazeNodeOne::operator=(const MazeNodeOne& other)
 {
-	if (this != &other)
+	if (this != &other) //The prize and the finish flag come with the contents, the finish path mark does not
 	{
-		MazeNode<MazeNodeOne*>* ptr1 = this;
-		const MazeNode<MazeNodeOne*>* ptr2 = &other;
-
-		*ptr1 = *ptr2; //Use polymorphism to copy the base class values.
+		flags = uint8_t((flags & ~(NODE_ONE_PRIZE_MASK | NODE_ONE_FINISH))
+			| (other.flags & (NODE_ONE_PRIZE_MASK | NODE_ONE_FINISH)));
 		sortKey = other.sortKey; //Copy the sortKey value.
 	}
 
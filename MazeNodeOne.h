@@ -4,18 +4,67 @@
 /*
 This is the class that implements the nodes in Level 1 of the maze.
 
-Note that MazeNodeOne is derived from MazeNode since it is going to be used in Level 1 of the maze,
-which is a binary search tree. To randomize the maze, each node will have a sort key that's to be
-randomly generated - but ONLY maze level one requires that sort key.
+Level 1 of the maze is a binary search tree. To randomize the maze, each node will have a sort key that's
+to be randomly generated - but ONLY maze level one requires that sort key. When the maze is built as a
+treap (see MazeLevelOne), each node also carries a random heap priority that keeps the tree balanced.
+
+The links are 32-bit indices into the NodeArena that owns the maze rather than pointers, NULL_NODE_INDEX
+being a dead end (see NodeLinks.h), and each node also remembers its own index, so that it can be linked to. Every field has
+a fixed width, the prize and the marks of the node sharing a byte of flags, and the class is standard
+layout, so a node takes the same 28 bytes on every compiler. Since nothing in a node is an address, a
+maze image stores the nodes as they are in memory, and a loaded maze is played straight from the mapped
+file (see MazeLevelOne::save and MazeLevelOne::load).
 */
 
-#include "MazeNode.h"
+#include "NodeLinks.h"
+
+#include <stdint.h>
+#include <type_traits>
+
+const int NODE_ONE_NUM_PATHS = 3; //Index 0 = backwards (the parent), 1 = left, 2 = right
 
-class MazeNodeOne : public MazeNode<MazeNodeOne*>
+const uint8_t NODE_ONE_PRIZE_MASK = 0x03; //Bits of the flags holding the prize code
+const uint8_t NODE_ONE_FINISH = 0x04; //Flag of the maze exit
+const uint8_t NODE_ONE_ON_FINISH_PATH = 0x08; //Flag of the nodes on the path from the start to the exit
+
+class MazeNodeOne
 {
 public:
-	MazeNodeOne(int prizeCode = 0, int pathNum = 3, bool isFinish = 0, int key = 0);
-	~MazeNodeOne();
+	MazeNodeOne(int prizeCode = 0, bool isFinish = 0, int key = 0, int nodePriority = 0);
+
+	/*
+	Copy constructor, used when a maze is copied. The links are left as dead ends, and the node index
+	is left unset, as the copy is stored elsewhere.
+	*/
+	MazeNodeOne(const MazeNodeOne&);
+
+	/*
+	Returns the prize number of the node. Note that 0 means no prize, 1 means that the node
+	contains a coin, while 2 means that the node has a power.
+	*/
+	int getPrizeNum() const;
+
+	/*
+	Returns true if the node is the finish node or maze exit.
+	*/
+	bool isFinish() const;
+
+	/*
+	Returns the number of paths of the node, i.e. NODE_ONE_NUM_PATHS.
+	*/
+	int getNumPaths() const;
+
+	/*
+	Returns the index of the next node at pathIndex if pathIndex is within the array bounds,
+	NULL_NODE_INDEX otherwise.
+	*/
+	uint32_t getNextNodePtr(int pathIndex) const;
+
+	/*
+	Sets the value of links[pathIndex] to nextNode if pathIndex is within the array bounds.
+	@return: True if pathIndex is within the array bounds, false otherwise.
+	*/
+	bool setNextNodePtr(int pathIndex, uint32_t nextNode);
 
 	/*
 	Returns the value of sortKey
@@ -23,13 +72,48 @@ public:
 	int getSortKey() const;
 
 	/*
-	Override the assignment operator to copy the value of sortKey.
+	Returns the treap priority of the node. Only meaningful for balanced mazes.
+	*/
+	int getPriority() const;
+
+	/*
+	Returns true if the node lies on the path from the start of the maze to the finish,
+	including the finish itself. Set with setOnFinishPath.
+	*/
+	bool isOnFinishPath() const;
+	void setOnFinishPath(bool onPath);
+
+	/*
+	Returns the flags of the node: the prize code, and the NODE_ONE_ flags above. Used to check the
+	nodes of a maze image.
+	*/
+	uint8_t getFlags() const;
+
+	/*
+	Returns the index of the node in the arena that stores it. Set with setNodeIndex once the node
+	is created.
+	*/
+	uint32_t getNodeIndex() const;
+	void setNodeIndex(uint32_t index);
+
+	/*
+	Override the assignment operator to copy the prize, the finish flag and the value of sortKey. The
+	links, the priority, the finish path mark and the node index belong to the node's position in the
+	tree rather than to its contents, so they are NOT copied.
 	Note this was only used to implement the remaining data structure functions,
 	and was not necessary to do the project itself.
 	*/
 	const MazeNodeOne& operator=(const MazeNodeOne&);
 private:
-	int sortKey; //Stores the sortKey of the node to insert into the BST.
+	uint32_t links[NODE_ONE_NUM_PATHS]; //Index of the node in each direction, NULL_NODE_INDEX for a dead end
+	int32_t sortKey; //Stores the sortKey of the node to insert into the BST.
+	int32_t priority; //Heap priority of the node when the BST is built as a treap
+	uint32_t nodeIndex; //Index of the node in its arena, used by the links of the other nodes
+	uint8_t flags; //Prize code, plus NODE_ONE_FINISH or NODE_ONE_ON_FINISH_PATH
+	uint8_t reserved[3]; //Always 0, so that a saved node holds no stray bytes
 };
 
+static_assert(std::is_standard_layout<MazeNodeOne>::value && sizeof(MazeNodeOne) == 28,
+		"A Level 1 node must keep its layout on every compiler, as maze images store it as it is");
+
 #endif
@@ -0,0 +1,88 @@
+/*
+This is the implementation file corresponding to MazeOverlay.h containing the definitions of the member functions.
+*/
+
+#include "MazeOverlay.h"
+
+MazeOverlay::MazeOverlay() : playerPtr(NULL), playerLoc(-1), collectedBits(NULL), numWords(0)
+{
+}
+
+MazeOverlay::MazeOverlay(const MazeOverlay& otherOverlay)
+	: playerPtr(NULL), playerLoc(-1), collectedBits(NULL), numWords(0)
+{
+	*this = otherOverlay;
+}
+
+MazeOverlay::~MazeOverlay()
+{
+	delete [] collectedBits;
+}
+
+MazeOverlay& MazeOverlay::operator=(const MazeOverlay& otherOverlay)
+{
+	if (this != &otherOverlay)
+	{
+		playerPtr = otherOverlay.playerPtr;
+		playerLoc = otherOverlay.playerLoc;
+		resetCollected();
+		if (numWords < otherOverlay.numWords)
+			grow(otherOverlay.numWords);
+
+		for (int i = 0; i < otherOverlay.numWords; ++i)
+			collectedBits[i] = otherOverlay.collectedBits[i];
+		collectedIds = otherOverlay.collectedIds;
+	}
+
+	return *this;
+}
+
+void MazeOverlay::start(Player* newPlayer, int startId)
+{
+	playerPtr = newPlayer;
+	playerLoc = (newPlayer ? startId : -1);
+	resetCollected();
+}
+
+void MazeOverlay::collect(int nodeId)
+{
+	if ((nodeId >> 6) >= numWords)
+		grow((nodeId >> 6) + 1);
+
+	collectedBits[nodeId >> 6] |= uint64_t(1) << (nodeId & 63);
+	collectedIds.push(nodeId);
+}
+
+void MazeOverlay::resetCollected()
+{
+	while (!collectedIds.empty())
+	{
+		collectedBits[collectedIds.top() >> 6] = 0; //Clears the other bits of the word along with it, which
+		collectedIds.pop();			//are either collected too or already 0
+	}
+}
+
+int MazeOverlay::getNumCollected() const
+{
+	return collectedIds.size();
+}
+
+size_t MazeOverlay::getBytesUsed() const
+{
+	return numWords * sizeof(uint64_t);
+}
+
+void MazeOverlay::grow(int minWords)
+{
+	int newNumWords = (numWords > 0 ? 2 * numWords : 1);
+	while (newNumWords < minWords)
+		newNumWords *= 2;
+
+	uint64_t* newBits = new uint64_t[newNumWords];
+	for (int i = 0; i < newNumWords; ++i)
+		newBits[i] = (i < numWords ? collectedBits[i] : 0);
+
+	delete [] collectedBits;
+	collectedBits = newBits;
+	numWords = newNumWords;
+}
@@ -0,0 +1,77 @@
+#ifndef _MAZE_OVERLAY_H
+#define _MAZE_OVERLAY_H
+
+/*
+This is the class holding the state of one game played in a maze: the player, their location and the
+prizes they collected. The mazes themselves are never changed by a game, so any number of overlays can
+play the same maze at once, each through the functions of MazeInterface taking an overlay, and the maze
+only needs to be built or copied once. The functions without an overlay play the overlay the maze owns.
+
+The collected prizes are a bitset indexed by the IDs of the nodes (see the levels), which only grows as
+far as the largest ID collected, so a game costs at most one bit per node of the maze. The IDs are also
+kept on a stack, so that starting over clears only the words that were set, in O(prizes collected).
+*/
+
+#include "Player.h"
+#include "Stack.h"
+
+#include <cstddef>
+#include <stdint.h>
+
+class MazeOverlay
+{
+public:
+	MazeOverlay(); //The overlay starts without a player
+	MazeOverlay(const MazeOverlay&); //Copy constructor, the copy shares the player of the other overlay
+	~MazeOverlay();
+
+	MazeOverlay& operator=(const MazeOverlay&);
+
+	//These are used on every move, so they are defined here to be inlined
+	Player* getPlayer() const { return playerPtr; } //Returns the player, NULL if there is none
+	int getLocation() const { return playerLoc; } //Returns the ID of the player's location, -1 if there is no player
+	void setLocation(int nodeId) { playerLoc = nodeId; }
+
+	/*
+	Starts a new game, used by setPlayer.
+	@post: The player is newPlayer, their location is startId (-1 if newPlayer is NULL), and no prize
+	is collected.
+	*/
+	void start(Player* newPlayer, int startId);
+
+	/*
+	Returns true if the prize of node nodeId was collected in this game.
+	*/
+	bool isCollected(int nodeId) const
+	{
+		return (nodeId >> 6) < numWords && (collectedBits[nodeId >> 6] >> (nodeId & 63)) & 1;
+	}
+
+	/*
+	Marks the prize of node nodeId, which must not be collected yet, as collected.
+	*/
+	void collect(int nodeId);
+
+	/*
+	Forgets the prizes collected, used by startOver.
+	@post: No prize is collected.
+	*/
+	void resetCollected();
+
+	int getNumCollected() const; //Returns the number of prizes collected since the last reset
+	size_t getBytesUsed() const; //Returns the number of bytes used by the bitset
+
+private:
+	Player* playerPtr; //Pointer to store the player
+	int playerLoc; //ID of the player's location in the maze, -1 if there is no player
+	uint64_t* collectedBits; //Bit i of word i / 64 is set if the prize of node i was collected
+	int numWords; //Number of words of collectedBits
+	Stack<int> collectedIds; //IDs of the nodes whose bit is set, to clear them in resetCollected
+
+	/*
+	Makes collectedBits at least minWords words long, doubling its size so that growing is rare.
+	*/
+	void grow(int minWords);
+};
+
+#endif
@@ -0,0 +1,69 @@
+/*
+This is the implementation file corresponding to MazeRandom.h containing the definitions of the member functions.
+*/
+
+#include "MazeRandom.h"
+
+#include <cstdlib>
+
+/*
+Rotates x to the left by k bits.
+*/
+static inline uint64_t rotateLeft(uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+MazeRandom::MazeRandom(uint64_t seed)
+{
+	setSeed(seed);
+}
+
+void MazeRandom::setSeed(uint64_t seed)
+{
+	this->seed = seed;
+
+	uint64_t splitState = seed; //splitmix64, each step gives one word of the state
+	for (int i = 0; i < 4; ++i)
+	{
+		uint64_t z = (splitState += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		state[i] = z ^ (z >> 31);
+	}
+}
+
+uint64_t MazeRandom::getSeed() const
+{
+	return seed;
+}
+
+uint64_t MazeRandom::next()
+{
+	uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+	uint64_t t = state[1] << 17;
+
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+
+	state[2] ^= t;
+	state[3] = rotateLeft(state[3], 45);
+
+	return result;
+}
+
+int MazeRandom::nextInt(int bound)
+{
+	return static_cast<int>(((next() >> 32) * static_cast<uint64_t>(bound)) >> 32);
+}
+
+uint64_t MazeRandom::makeSeed()
+{
+	uint64_t seed = static_cast<uint64_t>(rand()); //RAND_MAX may only be 2^15 - 1, so we combine a few draws
+	for (int i = 0; i < 3; ++i)
+		seed = (seed << 21) ^ static_cast<uint64_t>(rand());
+
+	return seed;
+}
@@ -0,0 +1,55 @@
+#ifndef _MAZE_RANDOM_H
+#define _MAZE_RANDOM_H
+
+/*
+This is the random number generator used to build the mazes. It implements xoshiro256**, which is
+much faster than rand() and whose whole state lives in the generator object instead of being shared by
+the entire program. Every maze owns its own generator, so mazes can be built on several threads at
+once, and a maze built from a given seed is always the same maze.
+
+The 256-bit state is filled in from the 64-bit seed with splitmix64, as recommended by the authors of
+xoshiro, so that any seed (including 0) gives a well mixed starting state.
+*/
+
+#include <stdint.h>
+
+class MazeRandom
+{
+public:
+	MazeRandom(uint64_t seed = 0); //Seeds the generator, see setSeed
+
+	/*
+	Restarts the generator from seed.
+	@post: The generator returns the same sequence as any other generator seeded with seed.
+	*/
+	void setSeed(uint64_t seed);
+
+	/*
+	Returns the seed the generator was last started from.
+	*/
+	uint64_t getSeed() const;
+
+	/*
+	Returns the next 64 random bits.
+	*/
+	uint64_t next();
+
+	/*
+	Returns a random number between 0 and bound - 1, the replacement for rand() % bound.
+	The number is scaled from the upper 32 bits with a multiplication rather than a division.
+	@param bound: The size of the range, between 1 and 2^31 - 1.
+	*/
+	int nextInt(int bound);
+
+	/*
+	Returns a seed drawn from rand(), for the mazes that are not given one explicitly. This keeps such
+	mazes random as long as the program calls srand once, like it did before.
+	*/
+	static uint64_t makeSeed();
+
+private:
+	uint64_t state[4]; //State of the generator
+	uint64_t seed; //Seed the state was filled in from
+};
+
+#endif
@@ -0,0 +1,306 @@
+/*
+This is the implementation file corresponding to MazeServer.h containing the definitions of the member functions.
+*/
+
+#include "MazeServer.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static MazeServer* signalledServer = NULL; //Server stopped by the signals, see stopOnSignals
+
+/*
+Signal handler stopping signalledServer.
+*/
+static void stopSignalledServer(int)
+{
+	if (signalledServer)
+		signalledServer->stop();
+}
+
+MazeServer::MazeServer(MazeLibrary& library)
+	: library(library), listenSocket(-1), epollFd(-1), stopFd(-1), connections(NULL), connectionsCapacity(0),
+		numSessions(0)
+{
+	socketPath[0] = '\0';
+}
+
+MazeServer::~MazeServer()
+{
+	if (signalledServer == this) //The signals go back to ending the process
+	{
+		signal(SIGINT, SIG_DFL);
+		signal(SIGTERM, SIG_DFL);
+		signalledServer = NULL;
+	}
+
+	for (int i = 0; i < connectionsCapacity; ++i)
+	{
+		if (connections[i])
+			closeConnection(connections[i]);
+	}
+	delete [] connections;
+
+	if (listenSocket >= 0)
+	{
+		close(listenSocket);
+		unlink(socketPath);
+	}
+	if (epollFd >= 0)
+		close(epollFd);
+	if (stopFd >= 0)
+		close(stopFd);
+}
+
+bool MazeServer::listen(const char* socketPath)
+{
+	sockaddr_un address;
+	if (listenSocket >= 0 || strlen(socketPath) >= sizeof(address.sun_path))
+		return false;
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, socketPath);
+	unlink(socketPath); //Left over by a previous server
+
+	listenSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	bool isListening = (listenSocket >= 0 && epollFd >= 0 && stopFd >= 0
+		&& bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0
+		&& ::listen(listenSocket, SOMAXCONN) == 0);
+
+	//In epoll, the data of the listening socket is NULL and the data of the eventfd is the address of
+	//stopFd, which tells them apart from the connections, whose data is their Connection.
+	if (isListening)
+	{
+		epoll_event event;
+		event.events = EPOLLIN;
+		event.data.ptr = NULL;
+		isListening = (epoll_ctl(epollFd, EPOLL_CTL_ADD, listenSocket, &event) == 0);
+		event.data.ptr = &stopFd;
+		isListening = isListening && epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &event) == 0;
+	}
+
+	if (isListening)
+		strcpy(this->socketPath, socketPath);
+	else
+	{
+		if (listenSocket >= 0)
+			close(listenSocket);
+		listenSocket = -1;
+	}
+
+	return isListening;
+}
+
+bool MazeServer::run()
+{
+	if (listenSocket < 0)
+		return false;
+
+	epoll_event events[SERVER_MAX_EVENTS];
+	bool isRunning = true;
+	while (isRunning)
+	{
+		int numEvents = epoll_wait(epollFd, events, SERVER_MAX_EVENTS, -1);
+		if (numEvents < 0 && errno != EINTR) //Interrupted by a signal, which is not an error
+			return false;
+
+		for (int i = 0; i < numEvents; ++i)
+		{
+			if (events[i].data.ptr == NULL)
+				acceptClients();
+			else if (events[i].data.ptr == &stopFd)
+			{
+				uint64_t count;
+				if (read(stopFd, &count, sizeof(count)) == sizeof(count)) //Clears it for the next run
+					isRunning = false;
+			}
+			else
+			{
+				Connection* connection = static_cast<Connection*>(events[i].data.ptr);
+				bool isOpen = true;
+				if (events[i].events & EPOLLOUT)
+					isOpen = handleOutput(connection);
+				if (isOpen && (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+					isOpen = handleInput(connection);
+
+				if (isOpen)
+					updateEvents(connection);
+				else
+					closeConnection(connection);
+			}
+		}
+	}
+
+	return true;
+}
+
+void MazeServer::stop()
+{
+	uint64_t one = 1;
+	if (write(stopFd, &one, sizeof(one)) < 0) //Nothing can be done about it, and the counter cannot
+		return;				//overflow from calls to stop
+}
+
+void MazeServer::stopOnSignals()
+{
+	signalledServer = this;
+	signal(SIGINT, stopSignalledServer);
+	signal(SIGTERM, stopSignalledServer);
+}
+
+int MazeServer::getNumSessions() const
+{
+	return numSessions;
+}
+
+void MazeServer::acceptClients()
+{
+	int clientSocket;
+	while ((clientSocket = accept4(listenSocket, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+	{
+		if (clientSocket >= connectionsCapacity) //Sockets are numbered from the lowest free one, so
+		{					//connections stays about as large as the number of clients
+			int newCapacity = (connectionsCapacity > 0 ? 2 * connectionsCapacity : 64);
+			while (newCapacity <= clientSocket)
+				newCapacity *= 2;
+
+			Connection** newConnections = new Connection*[newCapacity];
+			for (int i = 0; i < newCapacity; ++i)
+				newConnections[i] = (i < connectionsCapacity ? connections[i] : NULL);
+			delete [] connections;
+			connections = newConnections;
+			connectionsCapacity = newCapacity;
+		}
+
+		Connection* connection = new Connection;
+		connection->socket = clientSocket;
+		connection->inputLength = 0;
+		connection->outputLength = 0;
+		connection->events = EPOLLIN;
+
+		epoll_event event;
+		event.events = connection->events;
+		event.data.ptr = connection;
+		if (epoll_ctl(epollFd, EPOLL_CTL_ADD, clientSocket, &event) == 0)
+		{
+			connections[clientSocket] = connection;
+			numSessions++;
+		}
+		else
+		{
+			close(clientSocket);
+			delete connection;
+		}
+	}
+}
+
+bool MazeServer::handleInput(Connection* connection)
+{
+	if (connection->inputLength == SERVER_INPUT_BUFFER_SIZE) //Waiting for the client to read its replies
+		return true;
+
+	ssize_t numRead = recv(connection->socket, connection->input + connection->inputLength,
+		SERVER_INPUT_BUFFER_SIZE - connection->inputLength, 0);
+
+	if (numRead == 0) //The client disconnected
+		return false;
+	else if (numRead < 0)
+		return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+
+	connection->inputLength += numRead;
+	return runCommands(connection);
+}
+
+bool MazeServer::handleOutput(Connection* connection)
+{
+	return sendOutput(connection) && runCommands(connection); //Run the commands that were waiting for room
+}								//in the output buffer
+
+bool MazeServer::runCommands(Connection* connection)
+{
+	bool isOpen = true;
+	bool hasRunCommands = true;
+	while (isOpen && hasRunCommands) //Until every command has run, or the client stops taking replies
+	{
+		hasRunCommands = false;
+		int lineStart = 0;
+		char* lineEnd;
+		while (connection->outputLength + MAX_REPLY_LENGTH <= SERVER_OUTPUT_BUFFER_SIZE
+			&& (lineEnd = static_cast<char*>(memchr(connection->input + lineStart, '\n',
+				connection->inputLength - lineStart))) != NULL)
+		{
+			int lineLength = lineEnd - (connection->input + lineStart);
+			if (lineLength >= MAX_COMMAND_LENGTH)
+				return false;
+
+			connection->outputLength += connection->session.execute(connection->input + lineStart, lineLength,
+				connection->output + connection->outputLength, library);
+			lineStart += lineLength + 1;
+			hasRunCommands = true;
+		}
+
+		connection->inputLength -= lineStart;
+		memmove(connection->input, connection->input + lineStart, connection->inputLength);
+		if (connection->inputLength >= MAX_COMMAND_LENGTH && !memchr(connection->input, '\n', connection->inputLength))
+			return false; //A line that is too long to be a command
+
+		isOpen = sendOutput(connection); //Most of the time the socket takes all of the replies right away
+		hasRunCommands = hasRunCommands && connection->outputLength == 0;
+	}
+
+	return isOpen;
+}
+
+bool MazeServer::sendOutput(Connection* connection)
+{
+	if (connection->outputLength == 0)
+		return true;
+
+	ssize_t numSent = send(connection->socket, connection->output, connection->outputLength, MSG_NOSIGNAL);
+	if (numSent < 0)
+		return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+
+	connection->outputLength -= numSent;
+	memmove(connection->output, connection->output + numSent, connection->outputLength);
+
+	return true;
+}
+
+void MazeServer::updateEvents(Connection* connection)
+{
+	unsigned int events = 0;
+	if (connection->inputLength < SERVER_INPUT_BUFFER_SIZE)
+		events |= EPOLLIN;
+	if (connection->outputLength > 0)
+		events |= EPOLLOUT;
+
+	if (events != connection->events) //Most of the time nothing changes, and no system call is made
+	{
+		epoll_event event;
+		event.events = events;
+		event.data.ptr = connection;
+		epoll_ctl(epollFd, EPOLL_CTL_MOD, connection->socket, &event);
+		connection->events = events;
+	}
+}
+
+void MazeServer::closeConnection(Connection* connection)
+{
+	epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->socket, NULL);
+	close(connection->socket);
+	connections[connection->socket] = NULL;
+	numSessions--;
+	delete connection;
+}
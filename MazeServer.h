@@ -0,0 +1,119 @@
+#ifndef _MAZE_SERVER_H
+#define _MAZE_SERVER_H
+
+/*
+This is the class that lets many players play at once in a single process. It listens on a Unix domain
+socket, and every client that connects gets its own MazeSession, which runs the commands the client
+sends (see MazeSession for the protocol). The mazes come from a MazeLibrary shared by all sessions.
+
+The server runs on one thread, in an epoll event loop. The sockets are non-blocking, so a slow client
+never holds up the others: the commands of a client are run as soon as their lines have arrived, and
+the replies that could not be sent right away are kept until the client's socket can take them. A client
+that sends commands faster than it reads the replies is not read from until it catches up.
+
+This is Linux only, since it uses epoll and eventfd.
+*/
+
+#include "MazeLibrary.h"
+#include "MazeSession.h"
+
+const int SERVER_INPUT_BUFFER_SIZE = 256; //Bytes of commands buffered for each client
+const int SERVER_OUTPUT_BUFFER_SIZE = 4096; //Bytes of replies buffered for each client
+const int SERVER_MAX_EVENTS = 256; //Events handled per call to epoll_wait
+
+class MazeServer
+{
+public:
+	MazeServer(MazeLibrary& library); //The library must outlive the server
+	~MazeServer(); //Closes the connections and the socket, and removes the socket file
+
+	/*
+	Creates the socket at socketPath and starts listening on it. A file left at socketPath, e.g. by a
+	server that was killed, is removed first.
+	@return: True if the server is listening, false if the socket could not be created.
+	*/
+	bool listen(const char* socketPath);
+
+	/*
+	Runs the event loop on the calling thread until stop is called. listen must have succeeded.
+	@return: False if epoll failed, true otherwise.
+	*/
+	bool run();
+
+	/*
+	Makes run return. This only writes to an eventfd, so it can be called from any thread, and from a
+	signal handler.
+	*/
+	void stop();
+
+	/*
+	Makes the server stop when the process gets SIGINT (Ctrl-C) or SIGTERM, so that it can be destroyed
+	and remove its socket file. Only one server at a time can be stopped by the signals.
+	*/
+	void stopOnSignals();
+
+	int getNumSessions() const; //Returns the number of clients connected
+
+private:
+	/*
+	A connected client: their socket, their session and the bytes waiting to be read or sent.
+	*/
+	struct Connection
+	{
+		int socket;
+		MazeSession session;
+		char input[SERVER_INPUT_BUFFER_SIZE]; //Commands received but not run yet
+		int inputLength;
+		char output[SERVER_OUTPUT_BUFFER_SIZE]; //Replies not sent yet
+		int outputLength;
+		unsigned int events; //Events the connection is registered for in epoll
+	};
+
+	MazeLibrary& library;
+	int listenSocket; //-1 if the server is not listening
+	int epollFd;
+	int stopFd; //eventfd written by stop
+	char socketPath[108]; //Path of the socket file, removed by the destructor
+	Connection** connections; //Connections indexed by their socket, NULL where there is none
+	int connectionsCapacity; //Number of slots of connections
+	int numSessions;
+
+	/*
+	Accepts the clients waiting on the listening socket, until there are none left.
+	*/
+	void acceptClients();
+
+	/*
+	Reads from the client, runs the commands that arrived and sends the replies, or sends the replies
+	that are waiting if the socket can take them.
+	@return: False if the client disconnected or broke the protocol, in which case it must be closed.
+	*/
+	bool handleInput(Connection* connection);
+	bool handleOutput(Connection* connection);
+
+	/*
+	Runs the complete commands in the input buffer, as long as the output buffer has room for their
+	replies, and sends the replies.
+	@return: False if a command line is too long or the client is gone.
+	*/
+	bool runCommands(Connection* connection);
+
+	/*
+	Sends as much of the output buffer as the socket takes.
+	@return: False if the client is gone.
+	*/
+	bool sendOutput(Connection* connection);
+
+	/*
+	Registers the connection for the events it needs in epoll: readable if its input buffer has room,
+	writable if replies are waiting.
+	*/
+	void updateEvents(Connection* connection);
+
+	void closeConnection(Connection* connection);
+
+	MazeServer(const MazeServer&); //The server owns its sockets, so it cannot be copied
+	MazeServer& operator=(const MazeServer&);
+};
+
+#endif
@@ -0,0 +1,78 @@
+/*
+This is the implementation file corresponding to MazeSession.h containing the definitions of the member functions.
+*/
+
+#include "MazeSession.h"
+
+#include <cstdio>
+
+/*
+Reads the argument of a command, a number following the command letter and a space.
+@return: True if command is the letter, a space and a number, and nothing else.
+*/
+static bool readArgument(const char* command, int commandLength, int& argument)
+{
+	if (commandLength < 3 || command[1] != ' ')
+		return false;
+
+	int i = 2;
+	bool negative = (command[i] == '-');
+	if (negative)
+		i++;
+
+	argument = 0;
+	int firstDigit = i;
+	for (; i < commandLength && '0' <= command[i] && command[i] <= '9' && i - firstDigit < 9; ++i)
+		argument = 10 * argument + (command[i] - '0');
+
+	if (negative)
+		argument = -argument;
+
+	return (i > firstDigit && i == commandLength);
+}
+
+MazeSession::MazeSession() : mazePtr(NULL)
+{
+}
+
+int MazeSession::execute(const char* command, int commandLength, char* reply, MazeLibrary& library)
+{
+	int argument = 0;
+	char commandLetter = (commandLength > 0 ? command[0] : '\0');
+	bool isKnown = (commandLetter == 'N' || commandLetter == 'M' || commandLetter == 'R' || commandLetter == 'S');
+	bool hasArgument = (commandLetter == 'N' || commandLetter == 'M');
+
+	if (!isKnown || (hasArgument ? !readArgument(command, commandLength, argument) : commandLength != 1))
+		return snprintf(reply, MAX_REPLY_LENGTH, "E bad-command\n");
+
+	if (commandLetter == 'N') //New maze
+	{
+		const MazeInterface* newMaze = library.getMaze(argument);
+		if (!newMaze)
+			return snprintf(reply, MAX_REPLY_LENGTH, "E bad-level\n");
+
+		mazePtr = newMaze;
+		mazePtr->setPlayer(overlay, &player);
+		return snprintf(reply, MAX_REPLY_LENGTH, "N %d %d\n", argument, mazePtr->getNumPaths());
+	}
+
+	if (!mazePtr) //Every other command needs a maze
+		return snprintf(reply, MAX_REPLY_LENGTH, "E no-maze\n");
+
+	switch (commandLetter)
+	{
+		case 'M': //Move
+		{
+			MoveEvent event = mazePtr->makeMove(overlay, argument);
+			return snprintf(reply, MAX_REPLY_LENGTH, "M %d %d %d %d\n", event.outcome, event.prize, event.livesLeft,
+				event.nodeId);
+		}
+		case 'R': //Reveal
+			return snprintf(reply, MAX_REPLY_LENGTH, "R %d\n", mazePtr->revealPath(overlay));
+		case 'S': //Start over
+			mazePtr->startOver(overlay);
+			return snprintf(reply, MAX_REPLY_LENGTH, "S %d\n", player.getQuantity(0));
+		default:
+			return snprintf(reply, MAX_REPLY_LENGTH, "E bad-command\n");
+	}
+}
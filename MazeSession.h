@@ -0,0 +1,53 @@
+#ifndef _MAZE_SESSION_H
+#define _MAZE_SESSION_H
+
+/*
+This is the class holding the game of one client of MazeServer: their player, the maze they are
+playing, which is shared with the other clients, and their game in it (see MazeOverlay). It runs the commands of the server protocol, one line at a time, and writes the reply to each.
+
+The protocol is made of short lines of text ending with '\n', and every command gets exactly one reply:
+
+	Command		Reply				Meaning
+	N <level>	N <level> <number of paths>	Play a new maze of level 1 or 2, taken from the MazeLibrary
+	M <path>	M <outcome> <prize> <lives> <node>	Move the player with makeMove, see MoveEvent
+	R		R <path>			Use a power with revealPath, -1 if there is none to use
+	S		S <lives>			Start over, like startOver
+
+The outcome of a move is the number of its MoveOutcome. A command that cannot be run gets the reply
+"E <reason>" instead, e.g. "E no-maze" if the client has not asked for a maze yet.
+*/
+
+#include "MazeInterface.h"
+#include "MazeLibrary.h"
+#include "MazeOverlay.h"
+#include "Player.h"
+
+const int MAX_COMMAND_LENGTH = 32; //Longest command line, including its '\n'
+const int MAX_REPLY_LENGTH = 64; //Longest reply line, including its '\n'
+
+class MazeSession
+{
+public:
+	MazeSession(); //The session starts without a maze
+
+	/*
+	Runs one command of the protocol.
+	@param: command - The command line, without its '\n'.
+	commandLength - The number of characters of the command.
+	reply - Buffer of at least MAX_REPLY_LENGTH characters.
+	library - Where new mazes come from.
+	@post: reply holds the reply line, ending with '\n'.
+	@return: The number of characters of the reply.
+	*/
+	int execute(const char* command, int commandLength, char* reply, MazeLibrary& library);
+
+private:
+	Player player; //Collectibles of the client
+	const MazeInterface* mazePtr; //Maze the client is playing, owned by the library, NULL until they ask for one
+	MazeOverlay overlay; //Location and prizes collected of the client in the maze
+
+	MazeSession(const MazeSession&); //The overlay points to player, so the session cannot be copied
+	MazeSession& operator=(const MazeSession&);
+};
+
+#endif
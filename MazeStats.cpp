@@ -0,0 +1,99 @@
+/*
+This is the implementation file corresponding to MazeStats.h containing the definitions of the member functions.
+*/
+
+#include "MazeStats.h"
+
+const char* const OPERATION_NAMES[NUM_MAZE_OPERATIONS] = {"movePlayer", "reveal", "startOver", "makeMove", "revealPath"};
+const bool OPERATION_TIMED[NUM_MAZE_OPERATIONS] = {true, true, true, false, false}; //See MazeStats.h
+
+MazeStats::MazeStats() : generationStart(std::chrono::steady_clock::now()), generationNanos(0)
+{
+	for (int i = 0; i < MAZE_STATS_SHARDS; ++i)
+	{
+		for (int j = 0; j < NUM_MAZE_OPERATIONS; ++j)
+		{
+			shards[i].calls[j].store(0, std::memory_order_relaxed);
+			shards[i].totalNanos[j].store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+void MazeStats::addCall(MazeOperation operation, std::chrono::steady_clock::duration duration)
+{
+	Shard& shard = shards[getShardIndex()];
+	shard.calls[operation].fetch_add(1, std::memory_order_relaxed); //Only the counts matter, not the order
+	shard.totalNanos[operation].fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(),
+		std::memory_order_relaxed);
+}
+
+void MazeStats::addCalls(MazeOperation operation, uint64_t numCalls)
+{
+	shards[getShardIndex()].calls[operation].fetch_add(numCalls, std::memory_order_relaxed);
+}
+
+void MazeStats::startGeneration()
+{
+	generationStart = std::chrono::steady_clock::now();
+}
+
+void MazeStats::finishGeneration()
+{
+	generationNanos.store(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()
+		- generationStart).count(), std::memory_order_relaxed);
+}
+
+void MazeStats::read(MazeStatsReport& report) const
+{
+	for (int j = 0; j < NUM_MAZE_OPERATIONS; ++j)
+	{
+		uint64_t calls = 0, totalNanos = 0;
+		for (int i = 0; i < MAZE_STATS_SHARDS; ++i)
+		{
+			calls += shards[i].calls[j].load(std::memory_order_relaxed);
+			totalNanos += shards[i].totalNanos[j].load(std::memory_order_relaxed);
+		}
+		report.calls[j] = calls;
+		report.totalMillis[j] = totalNanos / 1000000.0;
+	}
+
+	report.generationMillis = generationNanos.load(std::memory_order_relaxed) / 1000000.0;
+}
+
+int MazeStats::getShardIndex()
+{
+	static std::atomic<int> nextShard(0);
+	static thread_local int shardIndex = nextShard.fetch_add(1, std::memory_order_relaxed) % MAZE_STATS_SHARDS;
+	return shardIndex;
+}
+
+void MazeStatsReport::print(std::ostream& out) const
+{
+	out << "Level " << level << " maze: " << nodesAllocated << " intersections, " << bytesUsed << " bytes, depth "
+		<< depth << ", " << deadEnds << " dead ends, " << coins << " coins, " << powers << " powers" << std::endl;
+	out << "Generated in " << generationMillis << " ms" << std::endl;
+	for (int i = 0; i < NUM_MAZE_OPERATIONS; ++i)
+	{
+		out << OPERATION_NAMES[i] << ": " << calls[i] << " calls";
+		if (OPERATION_TIMED[i])
+			out << ", " << totalMillis[i] << " ms";
+		if (OPERATION_TIMED[i] && calls[i] > 0)
+			out << ", " << totalMillis[i] * 1000000 / calls[i] << " ns per call";
+		out << std::endl;
+	}
+}
+
+void MazeStatsReport::printJson(std::ostream& out) const
+{
+	out << "{\"level\": " << level << ", \"nodes_allocated\": " << nodesAllocated << ", \"bytes_used\": " << bytesUsed
+		<< ", \"depth\": " << depth << ", \"dead_ends\": " << deadEnds << ", \"coins\": " << coins
+		<< ", \"powers\": " << powers << ", \"generation_ms\": " << generationMillis;
+	for (int i = 0; i < NUM_MAZE_OPERATIONS; ++i)
+	{
+		out << ", \"" << OPERATION_NAMES[i] << "\": {\"calls\": " << calls[i];
+		if (OPERATION_TIMED[i])
+			out << ", \"total_ms\": " << totalMillis[i];
+		out << "}";
+	}
+	out << "}" << std::endl;
+}
@@ -0,0 +1,140 @@
+#ifndef _MAZE_STATS_H
+#define _MAZE_STATS_H
+
+/*
+This is the class that counts the calls of a maze to movePlayer, reveal and startOver, along with the
+time they took, and remembers how long the maze took to generate. Every maze owns one (see
+MazeInterface::getStats), and it is meant to be left on: timing a call costs two reads of the clock and
+two relaxed atomic additions.
+
+The moves and reveals are also counted where they are made, by makeMove, makeMoves and revealPath,
+whether on the maze's own game or on a MazeOverlay (as MazeSession does), so games played without
+printing, like those of SimulationEngine and the benchmarks, are counted too. makeMoves adds all of its
+moves at once. A move can take a few nanoseconds, which is less than a read of the clock, so those
+calls are only counted, with one relaxed atomic addition, and not timed. startOver is timed for every
+game, its own or an overlay's.
+
+The counters are split into MAZE_STATS_SHARDS shards, padded so that no two of them share a cache line,
+and every thread adds to the shard it was given the first time it counted something. Threads counting
+calls to the same maze therefore do not fight over a cache line, and the shards are only added up when
+the counters are read. A read taken while calls are being counted may miss the calls in flight.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <stdint.h>
+
+/*
+The calls that are counted. STATS_MAKE_MOVE counts the moves made by makeMove and makeMoves, and
+neither it nor STATS_REVEAL_PATH is timed, see above.
+*/
+enum MazeOperation
+{
+	STATS_MOVE_PLAYER,
+	STATS_REVEAL,
+	STATS_START_OVER,
+	STATS_MAKE_MOVE,
+	STATS_REVEAL_PATH,
+	NUM_MAZE_OPERATIONS
+};
+
+const int MAZE_STATS_SHARDS = 16; //Number of shards the counters are split into, see above
+
+/*
+Everything known about a maze at the time it was read, see MazeInterface::getStats. The shape of the
+maze is counted over the intersections the player can reach, which stop at the finish.
+*/
+struct MazeStatsReport
+{
+	int level; //1 or 2
+	long long nodesAllocated; //Number of intersections stored
+	long long bytesUsed; //Bytes used by the intersections (see getArenaBytesUsed and getBytesUsed)
+	int depth; //Height of the tree for Level 1, breadth-first depth of the deepest intersection for Level 2
+	long long deadEnds; //Directions leading nowhere, not counting backwards from the start
+	long long coins; //Coins in the maze, whether or not they were collected
+	long long powers; //Powers in the maze, whether or not they were collected
+	double generationMillis; //Time taken to build, copy or load the maze
+	long long calls[NUM_MAZE_OPERATIONS]; //Number of calls to each operation
+	double totalMillis[NUM_MAZE_OPERATIONS]; //Total time spent in each operation, 0 for the ones not timed
+
+	/*
+	Writes the report as a few lines of text meant to be read by a person.
+	*/
+	void print(std::ostream& out) const;
+
+	/*
+	Writes the report as a single JSON object, followed by a newline, meant to be read by a program.
+	*/
+	void printJson(std::ostream& out) const;
+};
+
+class MazeStats
+{
+public:
+	/*
+	Times a call to an operation, from its creation to its destruction.
+	*/
+	class Timer
+	{
+	public:
+		Timer(MazeStats& stats, MazeOperation operation)
+			: stats(stats), operation(operation), start(std::chrono::steady_clock::now()) {}
+		~Timer() { stats.addCall(operation, std::chrono::steady_clock::now() - start); }
+
+	private:
+		MazeStats& stats;
+		MazeOperation operation;
+		std::chrono::steady_clock::time_point start;
+
+		Timer(const Timer&);
+		Timer& operator=(const Timer&);
+	};
+
+	MazeStats(); //All counters start at 0, and the generation timer starts
+
+	/*
+	Adds a call to operation that took duration to the counters of the calling thread's shard.
+	*/
+	void addCall(MazeOperation operation, std::chrono::steady_clock::duration duration);
+
+	/*
+	Adds numCalls calls to operation to the counters of the calling thread's shard, without any time.
+	*/
+	void addCalls(MazeOperation operation, uint64_t numCalls = 1);
+
+	/*
+	Start and stop the generation timer. The generation time is the time between the last calls to
+	both, and is only changed by finishGeneration, so a generation that fails can be left unfinished.
+	*/
+	void startGeneration();
+	void finishGeneration();
+
+	/*
+	Sets report.calls and report.totalMillis to the sums of the counters of every shard, and sets
+	report.generationMillis. The other members of report are left as they were.
+	*/
+	void read(MazeStatsReport& report) const;
+
+private:
+	struct Shard
+	{
+		std::atomic<uint64_t> calls[NUM_MAZE_OPERATIONS];
+		std::atomic<uint64_t> totalNanos[NUM_MAZE_OPERATIONS];
+		char padding[64]; //At least a cache line between two shards, wherever the maze was allocated
+	};
+
+	Shard shards[MAZE_STATS_SHARDS];
+	std::chrono::steady_clock::time_point generationStart;
+	std::atomic<uint64_t> generationNanos;
+
+	/*
+	Returns the shard of the calling thread. The threads are given the shards in turn.
+	*/
+	static int getShardIndex();
+
+	MazeStats(const MazeStats&); //The counters belong to one maze, so they cannot be copied
+	MazeStats& operator=(const MazeStats&);
+};
+
+#endif
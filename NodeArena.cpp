@@ -0,0 +1,194 @@
+#ifndef _NODE_ARENA_CPP //This avoids compilation issues with template classes
+#define _NODE_ARENA_CPP
+
+/*
+This is the implementation file corresponding to NodeArena.h containing the definitions of the member functions.
+*/
+
+#include "NodeArena.h"
+
+#include <new>
+#include <utility>
+#include <type_traits>
+
+template <class ItemType>
+NodeArena<ItemType>::NodeArena(int nodesPerChunk)
+	: chunkArray(NULL), numChunks(0), chunkArraySize(0), nodesPerChunk(1), chunkShift(0), numAdoptedChunks(0),
+		numAdoptedNodes(0), nextSlot(0), freeList(NULL_NODE_INDEX), liveNodes(0)
+{
+	static_assert(std::is_trivially_destructible<ItemType>::value,
+			"NodeArena releases its chunks without calling the node destructors");
+	static_assert(sizeof(ItemType) >= sizeof(uint32_t), "Released nodes must be able to hold the free list link");
+
+	setNodesPerChunk(nodesPerChunk);
+	nextSlot = this->nodesPerChunk; //No chunk yet, so the "last chunk" is full
+}
+
+template <class ItemType>
+void NodeArena<ItemType>::setNodesPerChunk(int nodesPerChunk)
+{
+	this->nodesPerChunk = 1;
+	chunkShift = 0;
+	while (this->nodesPerChunk < nodesPerChunk) //Round up to the next power of two
+	{
+		this->nodesPerChunk <<= 1;
+		chunkShift++;
+	}
+}
+
+template <class ItemType>
+NodeArena<ItemType>::~NodeArena()
+{
+	clear();
+}
+
+template <class ItemType>
+template <class... Args>
+ItemType* NodeArena<ItemType>::create(Args&&... args)
+{
+	return new (getNode(allocate())) ItemType(std::forward<Args>(args)...);
+}
+
+template <class ItemType>
+template <class... Args>
+uint32_t NodeArena<ItemType>::createIndex(Args&&... args)
+{
+	uint32_t index = allocate();
+	new (getNode(index)) ItemType(std::forward<Args>(args)...);
+	return index;
+}
+
+template <class ItemType>
+ItemType* NodeArena<ItemType>::getNode(uint32_t index) const
+{
+	return reinterpret_cast<ItemType*>(chunkArray[index >> chunkShift])
+		+ (index & static_cast<uint32_t>(nodesPerChunk - 1));
+}
+
+template <class ItemType>
+uint32_t NodeArena<ItemType>::allocate()
+{
+	uint32_t index;
+	if (freeList != NULL_NODE_INDEX) //Reuse a released node first
+	{
+		index = freeList;
+		freeList = *reinterpret_cast<uint32_t*>(getNode(index));
+	}
+	else
+	{
+		if (nextSlot == nodesPerChunk) //The last chunk is full, so we need a new one
+		{
+			if (numChunks == chunkArraySize) //Grow the chunk array by doubling it
+			{
+				chunkArraySize = (chunkArraySize ? 2*chunkArraySize : 8);
+				char** newArray = new char*[chunkArraySize];
+				for (int i = 0; i < numChunks; ++i)
+					newArray[i] = chunkArray[i];
+				delete [] chunkArray;
+				chunkArray = newArray;
+			}
+
+			chunkArray[numChunks++] = static_cast<char*>(::operator new(sizeof(ItemType) * nodesPerChunk));
+			nextSlot = 0;
+		}
+
+		index = (static_cast<uint32_t>(numChunks - 1) << chunkShift) | static_cast<uint32_t>(nextSlot++);
+	}
+
+	liveNodes++;
+	return index;
+}
+
+template <class ItemType>
+void NodeArena<ItemType>::release(uint32_t index)
+{
+	if (index != NULL_NODE_INDEX) //Nodes are trivially destructible, so we only need to put the memory
+	{				//on the free list
+		*reinterpret_cast<uint32_t*>(getNode(index)) = freeList;
+		freeList = index;
+		liveNodes--;
+	}
+}
+
+template <class ItemType>
+void NodeArena<ItemType>::clear()
+{
+	for (int i = numAdoptedChunks; i < numChunks; ++i) //The adopted memory belongs to someone else
+		::operator delete(chunkArray[i]);
+	delete [] chunkArray;
+
+	chunkArray = NULL;
+	numChunks = 0;
+	chunkArraySize = 0;
+	numAdoptedChunks = 0;
+	numAdoptedNodes = 0;
+	nextSlot = nodesPerChunk;
+	freeList = NULL_NODE_INDEX;
+	liveNodes = 0;
+}
+
+template <class ItemType>
+void NodeArena<ItemType>::reset(int nodesPerChunk)
+{
+	clear();
+	setNodesPerChunk(nodesPerChunk);
+	nextSlot = this->nodesPerChunk; //No chunk yet, so the "last chunk" is full
+}
+
+template <class ItemType>
+void NodeArena<ItemType>::adopt(ItemType* nodes, uint32_t numNodes)
+{
+	clear();
+	if (nodesPerChunk < DEFAULT_ARENA_CHUNK_NODES)
+		setNodesPerChunk(DEFAULT_ARENA_CHUNK_NODES);
+
+	//The block is cut into chunks of nodesPerChunk nodes, so that node i keeps index i. The last of them
+	//may be partly past the end of the block, but its missing slots are never handed out.
+	numChunks = static_cast<int>((static_cast<uint64_t>(numNodes) + nodesPerChunk - 1) >> chunkShift);
+	numAdoptedChunks = numChunks;
+	numAdoptedNodes = numNodes;
+	chunkArraySize = numChunks;
+	chunkArray = (numChunks > 0 ? new char*[numChunks] : NULL);
+	for (int i = 0; i < numChunks; ++i)
+		chunkArray[i] = reinterpret_cast<char*>(nodes + (static_cast<size_t>(i) << chunkShift));
+
+	nextSlot = nodesPerChunk; //New nodes start a chunk of their own
+	liveNodes = numNodes;
+}
+
+template <class ItemType>
+size_t NodeArena<ItemType>::getBytesUsed() const
+{
+	return liveNodes * sizeof(ItemType);
+}
+
+template <class ItemType>
+size_t NodeArena<ItemType>::getBytesAllocated() const
+{
+	return static_cast<size_t>(numChunks) * nodesPerChunk * sizeof(ItemType);
+}
+
+template <class ItemType>
+int NodeArena<ItemType>::getNumChunks() const
+{
+	return numChunks;
+}
+
+template <class ItemType>
+int NodeArena<ItemType>::getNodesPerChunk() const
+{
+	return nodesPerChunk;
+}
+
+template <class ItemType>
+int NodeArena<ItemType>::getChunkSlots(int chunk) const
+{
+	if (chunk == numAdoptedChunks - 1) //The last adopted chunk can be partly past the adopted memory
+		return static_cast<int>(numAdoptedNodes - (static_cast<uint32_t>(chunk) << chunkShift));
+	else if (chunk == numChunks - 1) //The last chunk is filled up to nextSlot
+		return nextSlot;
+	else
+		return (0 <= chunk && chunk < numChunks ? nodesPerChunk : 0);
+}
+
+#endif
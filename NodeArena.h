@@ -0,0 +1,126 @@
+#ifndef _NODE_ARENA_H
+#define _NODE_ARENA_H
+
+/*
+Arena (slab) allocator for the nodes of a maze. Nodes are carved out of large chunks of memory instead of
+being allocated one at a time, and the entire maze is freed by releasing the chunks when the arena is
+destroyed or cleared. This turns the teardown of a maze into a handful of deallocations regardless of
+how many nodes it has.
+
+Because the chunks are released without visiting the individual nodes, ItemType must be trivially
+destructible (i.e. the nodes cannot own any other memory). Single nodes can still be given back to the
+arena with release(), where they are kept on a free list and reused by the next call to create().
+
+Every slot of the arena also has a 32-bit index, counting slots in the order the chunks hand them out.
+Since the chunk size is a power of two, getNode turns an index back into a node with a shift and a mask,
+so the arena doubles as the node table for mazes whose nodes are linked by index (see NodeLinks.h).
+*/
+
+#include "NodeLinks.h"
+
+#include <cstddef>
+#include <stdint.h>
+
+const int DEFAULT_ARENA_CHUNK_NODES = 4096; //Default number of nodes stored in each chunk
+
+template <class ItemType>
+class NodeArena
+{
+public:
+	/*
+	Creates an empty arena. No memory is allocated until the first node is created.
+	@param nodesPerChunk: The number of nodes in each chunk. It is rounded up to the next power of two.
+	*/
+	NodeArena(int nodesPerChunk = DEFAULT_ARENA_CHUNK_NODES);
+	~NodeArena(); //Releases all of the chunks
+
+	/*
+	Constructs a new node inside the arena, passing args to the ItemType constructor.
+	@return: A pointer to the new node.
+	*/
+	template <class... Args>
+	ItemType* create(Args&&... args);
+
+	/*
+	Same as create, but returns the index of the new node instead of a pointer to it.
+	*/
+	template <class... Args>
+	uint32_t createIndex(Args&&... args);
+
+	/*
+	Returns the node having the given index. The index must belong to a node created by this arena.
+	*/
+	ItemType* getNode(uint32_t index) const;
+
+	/*
+	Gives a single node back to the arena so that its memory can be reused by create().
+	@param index: The index of a node that was created by this arena. NULL_NODE_INDEX is ignored.
+	*/
+	void release(uint32_t index);
+
+	/*
+	Releases every chunk of the arena at once. All nodes created by the arena become invalid.
+	@post: The arena is empty and holds no memory.
+	*/
+	void clear();
+
+	/*
+	Releases every chunk, as clear does, and changes the number of nodes in each chunk, e.g. before a
+	maze of another size is stored in the arena.
+	@param nodesPerChunk: The number of nodes in each chunk. It is rounded up to the next power of two.
+	*/
+	void reset(int nodesPerChunk);
+
+	/*
+	Makes the arena use numNodes nodes that are stored one after the other at nodes, in memory that the
+	arena does not own (e.g. a mapped maze image, see MazeImage). The node at nodes[i] gets index i, so
+	the nodes can keep linking to each other by index. Nodes created afterwards go into chunks of their
+	own, but the adopted nodes must not be released, as that writes to their memory, which may be read
+	only. The memory must stay valid until the arena is cleared or destroyed, and is never freed by it.
+	@post: The arena holds the numNodes nodes, and nothing else. If its chunks were smaller than
+	DEFAULT_ARENA_CHUNK_NODES, they are now that size, so that a large block does not need many chunks.
+	*/
+	void adopt(ItemType* nodes, uint32_t numNodes);
+
+	size_t getBytesUsed() const; //Returns the number of bytes occupied by live nodes
+	size_t getBytesAllocated() const; //Returns the number of bytes held in chunks
+	int getNumChunks() const; //Returns the number of chunks allocated
+	int getNodesPerChunk() const; //Returns the number of nodes stored in each chunk
+
+	/*
+	Returns the number of slots that were handed out from a chunk, starting at index chunk << log2(nodesPerChunk).
+	They include the released nodes, so every index the arena handed out is in one of these ranges.
+	*/
+	int getChunkSlots(int chunk) const;
+
+private:
+	char** chunkArray; //Array of pointers to the chunks
+	int numChunks; //Number of chunks in chunkArray
+	int chunkArraySize; //Size of chunkArray
+	int nodesPerChunk; //Number of nodes that fit into each chunk
+	int chunkShift; //log2(nodesPerChunk), the index of a node is (chunk << chunkShift) | slot
+	int numAdoptedChunks; //Number of chunks at the start of chunkArray that point into adopted memory
+	uint32_t numAdoptedNodes; //Number of nodes in the adopted memory
+	int nextSlot; //Index of the next unused slot in the last chunk
+	uint32_t freeList; //Singly linked list of released nodes, the index of the next one is stored in the
+				//node's memory
+	size_t liveNodes; //Number of nodes currently handed out
+
+	/*
+	Returns the index of an uninitialized slot for one node, either from the free list or from the last
+	chunk. A new chunk is allocated if the last one is full.
+	*/
+	uint32_t allocate();
+
+	/*
+	Sets nodesPerChunk to nodesPerChunk rounded up to the next power of two, along with chunkShift.
+	*/
+	void setNodesPerChunk(int nodesPerChunk);
+
+	NodeArena(const NodeArena&); //The arena owns its chunks, so it cannot be copied
+	NodeArena& operator=(const NodeArena&);
+};
+
+#include "NodeArena.cpp"
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef _NODE_LINKS_H
+#define _NODE_LINKS_H
+
+/*
+Link policies for FixedMazeNode. A policy decides what a "null" link is for the type that is stored
+in the node's path array, so that getNextNodePtr keeps its dead-end semantics for both kinds of links:
+
+PointerLinks - The links are pointers to the next nodes, and NULL is a dead end. This is the default.
+IndexLinks - The links are 32-bit indices into a node table owned by the maze (see NodeArena::getNode),
+	and NULL_NODE_INDEX is a dead end. An index takes half the space of a pointer, and since it does not
+	depend on where the nodes are in memory, a maze linked by indices can be relocated as a whole.
+*/
+
+#include <cstddef>
+#include <stdint.h>
+
+const uint32_t NULL_NODE_INDEX = 0xFFFFFFFF; //Index used for a dead end, never handed out by NodeArena
+
+template <class ItemType>
+struct PointerLinks
+{
+	static ItemType getNullLink() { return NULL; }
+};
+
+struct IndexLinks
+{
+	static uint32_t getNullLink() { return NULL_NODE_INDEX; }
+};
+
+#endif
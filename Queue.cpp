@@ -9,71 +9,130 @@ Queue.h.
 #include "Queue.h"
 
 #include <cassert>
-#include <iostream>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+const int DEFAULT_QUEUE_CAPACITY = 16; //Capacity of the ring buffer after the first push
 
 template <class ItemType>
-Queue<ItemType>::Queue() : backPtr(NULL)
+Queue<ItemType>::Queue() : items(NULL), capacity(0), frontIndex(0), numItems(0)
 {
 }
 
 template <class ItemType>
-Queue<ItemType>::Queue(const Queue<ItemType>& aQueue) : backPtr(NULL)
+Queue<ItemType>::Queue(const Queue<ItemType>& aQueue) : items(NULL), capacity(0), frontIndex(0), numItems(0)
 {
-	if (!aQueue.empty()) //Copying a circular linked list if the other Queue isn't empty
-	{
-		backPtr = new Node<ItemType>(aQueue.backPtr->getItem());
-		backPtr->setNext(backPtr);
-		Node<ItemType>* otherCurrent = aQueue.backPtr->getNext();
-		Node<ItemType>* trailCurrent = backPtr;
-		while (otherCurrent != aQueue.backPtr)
-		{
-			Node<ItemType>* newNode = new Node<ItemType>(otherCurrent->getItem());
-			trailCurrent->setNext(newNode);
-			trailCurrent = newNode;
-			otherCurrent = otherCurrent->getNext();
-		}
-		trailCurrent->setNext(backPtr);
-	}
+	reserve(aQueue.numItems);
+	for (int i = 0; i < aQueue.numItems; ++i) //Copy the items in order, starting from the front
+		push(aQueue.items[(aQueue.frontIndex + i) & (aQueue.capacity - 1)]);
 }
 
 template <class ItemType>
 Queue<ItemType>::~Queue()
 {
-	if (!empty()) //Delete the contents of a circular linked list. Note that all cases are handled
+	destroyAll();
+}
+
+template <class ItemType>
+Queue<ItemType>& Queue<ItemType>::operator=(const Queue<ItemType>& aQueue)
+{
+	if (this != &aQueue)
 	{
-		Node<ItemType>* current = backPtr->getNext();
-		while (current != backPtr)
-		{
-			Node<ItemType>* storeNext = current->getNext();
-			delete current;
-			current = storeNext;
-		}
-		delete current;
-		backPtr = NULL;
+		while (pop()); //Keep our buffer, but empty it before copying the other queue
+		frontIndex = 0;
+
+		reserve(aQueue.numItems);
+		for (int i = 0; i < aQueue.numItems; ++i)
+			push(aQueue.items[(aQueue.frontIndex + i) & (aQueue.capacity - 1)]);
 	}
+
+	return *this;
 }
 
 template <class ItemType>
-bool Queue<ItemType>::empty() const
+void Queue<ItemType>::destroyAll()
 {
-	return (!backPtr);
+	while (pop()); //Destroy the remaining items, then free the buffer itself
+	::operator delete(items);
+
+	items = NULL;
+	capacity = 0;
+	frontIndex = 0;
 }
 
 template <class ItemType>
-bool Queue<ItemType>::push(const ItemType& newEntry)
+void Queue<ItemType>::grow(int newCapacity)
 {
-	Node<ItemType>* newNode = new Node<ItemType>(newEntry);
-	if (!empty()) //Insert into a non-empty circular list.
+	moveItems(static_cast<ItemType*>(::operator new(sizeof(ItemType) * newCapacity)), newCapacity);
+}
+
+template <class ItemType>
+void Queue<ItemType>::moveItems(ItemType* newItems, int newCapacity)
+{
+	for (int i = 0; i < numItems; ++i) //Move the items to the start of the new buffer
 	{
-		newNode->setNext(backPtr->getNext());
-		backPtr->setNext(newNode);
-		backPtr = newNode;
+		ItemType& oldItem = items[(frontIndex + i) & (capacity - 1)];
+		new (newItems + i) ItemType(std::move(oldItem));
+		oldItem.~ItemType();
 	}
-	else //Queue is empty, so we create a new head node
+	::operator delete(items);
+
+	items = newItems;
+	capacity = newCapacity;
+	frontIndex = 0;
+}
+
+template <class ItemType>
+void Queue<ItemType>::reserve(int numEntries)
+{
+	if (numEntries > capacity) //Only ever grow the buffer
 	{
-		backPtr = newNode;
-		backPtr->setNext(backPtr);
+		int newCapacity = (capacity ? capacity : 1);
+		while (newCapacity < numEntries)
+			newCapacity <<= 1;
+		grow(newCapacity);
 	}
+}
+
+template <class ItemType>
+bool Queue<ItemType>::empty() const
+{
+	return (numItems == 0);
+}
+
+template <class ItemType>
+int Queue<ItemType>::size() const
+{
+	return numItems;
+}
+
+template <class ItemType>
+bool Queue<ItemType>::push(const ItemType& newEntry)
+{
+	return emplace(newEntry);
+}
+
+template <class ItemType>
+bool Queue<ItemType>::push(ItemType&& newEntry)
+{
+	return emplace(std::move(newEntry));
+}
+
+template <class ItemType>
+template <class... Args>
+bool Queue<ItemType>::emplace(Args&&... args)
+{
+	if (numItems == capacity) //Buffer is full, so we double it. args may refer to an item of the queue,
+	{				//so the new item is constructed before the old ones are moved
+		int newCapacity = (capacity ? 2*capacity : DEFAULT_QUEUE_CAPACITY);
+		ItemType* newItems = static_cast<ItemType*>(::operator new(sizeof(ItemType) * newCapacity));
+		new (newItems + numItems) ItemType(std::forward<Args>(args)...); //The back once the items are moved
+		moveItems(newItems, newCapacity);
+	}
+	else
+		new (items + ((frontIndex + numItems) & (capacity - 1))) ItemType(std::forward<Args>(args)...);
+	numItems++;
 
 	return true;
 }
@@ -84,20 +143,19 @@ bool Queue<ItemType>::pop()
 	bool ableToRemove = (!empty());
 	if (ableToRemove) //Queue isn't empty
 	{
-		Node<ItemType>* storeNext = backPtr->getNext();
-		if (storeNext == backPtr) //Single node case
-			backPtr = NULL;
-		else //More than one node
-			backPtr->setNext(storeNext->getNext());
-		delete storeNext;
+		items[frontIndex].~ItemType();
+		frontIndex = (frontIndex + 1) & (capacity - 1);
+		numItems--;
 	}
+
+	return ableToRemove;
 }
 
 template <class ItemType>
-ItemType Queue<ItemType>::front() const
+const ItemType& Queue<ItemType>::front() const
 {
 	assert(!empty()); //Assert that the queue isn't empty.
-	return ((backPtr->getNext())->getItem()); //Return the front of the queue.
+	return items[frontIndex]; //Return the front of the queue.
 }
 
 #endif
@@ -1,16 +1,23 @@
 #ifndef _QUEUE_H
 #define _QUEUE_H
 
-//Queue class, implemented as a circular linked list.
-//Has the standard functions of a typical queue.
-
-#include "Node.h"
+//Queue class, implemented as a growable ring buffer whose capacity is always a power of two.
+//Has the standard functions of a typical queue. Items are stored contiguously, so pushing and popping
+//do not allocate any memory unless the buffer has to grow.
 
 template <class ItemType>
 class Queue
 {
 private:
-	Node<ItemType>* backPtr; //Pointer to the back of the queue.
+	ItemType* items; //Ring buffer storing the items. Only the slots between frontIndex and the back are constructed
+	int capacity; //Size of the ring buffer, always 0 or a power of two
+	int frontIndex; //Index of the front of the queue in items
+	int numItems; //Number of items in the queue
+
+	void grow(int newCapacity); //Moves the items into a new ring buffer having newCapacity slots
+	void moveItems(ItemType* newItems, int newCapacity); //Moves the items to the start of newItems, a ring
+								//buffer having newCapacity slots, and frees the old buffer
+	void destroyAll(); //Destroys the items and frees the ring buffer
 
 public:
 	//Constructors and Destructor
@@ -18,11 +25,27 @@ public:
 	Queue(const Queue<ItemType>& aQueue);
 	~Queue();
 
+	Queue<ItemType>& operator=(const Queue<ItemType>& aQueue);
+
 	bool empty() const; //Checks if the queue is empty
+	int size() const; //Returns the number of items in the queue
 	bool push(const ItemType& newEntry); //Pushes newEntry to the end of the queue
+	bool push(ItemType&& newEntry); //Moves newEntry to the end of the queue
 	bool pop(); //Removes the item at the front of the queue
 
-	ItemType front() const; //Returns the item at the front of the queue
+	/*
+	Constructs a new item in place at the end of the queue, passing args to the ItemType constructor.
+	*/
+	template <class... Args>
+	bool emplace(Args&&... args);
+
+	/*
+	Makes sure the queue can hold at least numEntries items without reallocating.
+	@post: The capacity of the queue is at least numEntries, rounded up to a power of two.
+	*/
+	void reserve(int numEntries);
+
+	const ItemType& front() const; //Returns the item at the front of the queue
 };
 
 #include "Queue.cpp"
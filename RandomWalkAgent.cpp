@@ -0,0 +1,27 @@
+/*
+This is the implementation file corresponding to RandomWalkAgent.h containing the definitions of the member functions.
+*/
+
+#include "RandomWalkAgent.h"
+
+RandomWalkAgent::RandomWalkAgent(uint64_t seed) : random(seed), numPaths(1)
+{
+}
+
+void RandomWalkAgent::newMaze(int numPaths)
+{
+	this->numPaths = numPaths;
+}
+
+void RandomWalkAgent::startGame()
+{
+}
+
+int RandomWalkAgent::chooseMove()
+{
+	return random.nextInt(numPaths);
+}
+
+void RandomWalkAgent::moveResult(int, MoveOutcome) //Nothing to learn
+{
+}
@@ -0,0 +1,27 @@
+#ifndef _RANDOM_WALK_AGENT_H
+#define _RANDOM_WALK_AGENT_H
+
+/*
+Agent that picks every move at random, backwards included. It learns nothing from its moves, so it
+gives the baseline that the other agents are compared against.
+*/
+
+#include "MazeAgent.h"
+#include "MazeRandom.h"
+
+class RandomWalkAgent : public MazeAgent
+{
+public:
+	RandomWalkAgent(uint64_t seed = 0); //The moves are drawn from a generator started from seed
+
+	void newMaze(int numPaths); //Described in MazeAgent
+	void startGame(); //Described in MazeAgent
+	int chooseMove(); //Described in MazeAgent
+	void moveResult(int pathIndex, MoveOutcome outcome); //Described in MazeAgent
+
+private:
+	MazeRandom random; //Generates the moves
+	int numPaths; //Number of directions of the maze
+};
+
+#endif
@@ -0,0 +1,274 @@
+/*
+This is the implementation file corresponding to ScoreEstimator.h containing the definitions of the member functions.
+*/
+
+#include "ScoreEstimator.h"
+#include "MazeLevelOne.h"
+#include "MazeLevelTwo.h"
+#include "MazeRandom.h"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+/*
+Packs a range of tasks into the word of a worker, and unpacks it.
+*/
+static uint64_t makeRange(uint64_t first, uint64_t end)
+{
+	return first | (end << 32);
+}
+
+static uint64_t getFirst(uint64_t range)
+{
+	return range & 0xFFFFFFFF;
+}
+
+static uint64_t getEnd(uint64_t range)
+{
+	return range >> 32;
+}
+
+/*
+Returns the half width of the confidence interval of the mean of numSamples samples, from their sum
+and the sum of their squares.
+*/
+static double findMargin(long long numSamples, double sum, double squares)
+{
+	if (numSamples < 2)
+		return 0;
+
+	double mean = sum / numSamples;
+	double variance = (squares - sum * mean) / (numSamples - 1);
+	return (variance > 0 ? CONFIDENCE_Z * std::sqrt(variance / numSamples) : 0);
+}
+
+double ScoreEstimate::getGamesPerSecond() const
+{
+	return (seconds > 0 ? numGames / seconds : 0);
+}
+
+double ScoreEstimate::getMovesPerSecond() const
+{
+	return (seconds > 0 ? numMoves / seconds : 0);
+}
+
+ScoreEstimator::ScoreEstimator(int numWorkers, int maxMovesPerGame) : numWorkers(numWorkers), maxMovesPerGame(maxMovesPerGame)
+{
+	if (this->numWorkers <= 0)
+		this->numWorkers = std::thread::hardware_concurrency();
+	if (this->numWorkers <= 0) //The number of cores is not known
+		this->numWorkers = 1;
+}
+
+ScoreEstimate ScoreEstimator::estimate(const MazeInterface& maze, AgentMaker makeAgent, long long numGames, uint64_t seed)
+{
+	Job job = {&maze, 0, 0, false, numGames, makeAgent, seed};
+	return run(job, numGames > 0 ? (numGames + GAMES_PER_TASK - 1) / GAMES_PER_TASK : 0);
+}
+
+ScoreEstimate ScoreEstimator::estimateOverMazes(int level, int numNodes, int numMazes, int gamesPerMaze,
+		AgentMaker makeAgent, uint64_t seed, bool balancedLevelOne)
+{
+	Job job = {NULL, level, numNodes, balancedLevelOne, gamesPerMaze, makeAgent, seed};
+	return run(job, (level == 1 || level == 2) && gamesPerMaze > 0 && numMazes > 0 ? numMazes : 0);
+}
+
+int ScoreEstimator::getNumWorkers() const
+{
+	return numWorkers;
+}
+
+ScoreEstimate ScoreEstimator::run(const Job& job, long long numTasks)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	Worker* workers = new Worker[numWorkers];
+	for (int i = 0; i < numWorkers; ++i)
+	{
+		workers[i].tasks = makeRange(numTasks * i / numWorkers, numTasks * (i + 1) / numWorkers);
+		workers[i].numGames = workers[i].numWins = workers[i].numGameOvers = workers[i].numAbandoned = 0;
+		workers[i].numMoves = workers[i].numSamples = workers[i].numSteals = 0;
+		workers[i].scoreSum = workers[i].scoreSquares = workers[i].winSum = workers[i].winSquares = 0;
+	}
+
+	//The calling thread is worker 0
+	std::thread* threads = new std::thread[numWorkers - 1];
+	for (int i = 1; i < numWorkers; ++i)
+		threads[i - 1] = std::thread(&ScoreEstimator::runWorker, this, std::cref(job), workers, i);
+	runWorker(job, workers, 0);
+	for (int i = 1; i < numWorkers; ++i)
+		threads[i - 1].join();
+	delete [] threads;
+
+	//The workers are done, so their totals can be read
+	ScoreEstimate estimate = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, numWorkers, 0, 0};
+	double scoreSum = 0, scoreSquares = 0, winSum = 0, winSquares = 0;
+	for (int i = 0; i < numWorkers; ++i)
+	{
+		estimate.numGames += workers[i].numGames;
+		estimate.numWins += workers[i].numWins;
+		estimate.numGameOvers += workers[i].numGameOvers;
+		estimate.numAbandoned += workers[i].numAbandoned;
+		estimate.numMoves += workers[i].numMoves;
+		estimate.numSamples += workers[i].numSamples;
+		estimate.numSteals += workers[i].numSteals;
+		scoreSum += workers[i].scoreSum;
+		scoreSquares += workers[i].scoreSquares;
+		winSum += workers[i].winSum;
+		winSquares += workers[i].winSquares;
+	}
+	delete [] workers;
+
+	if (estimate.numSamples > 0)
+	{
+		estimate.meanScore = scoreSum / estimate.numSamples;
+		estimate.scoreMargin = findMargin(estimate.numSamples, scoreSum, scoreSquares);
+		estimate.winRate = double(estimate.numWins) / estimate.numGames;
+		estimate.winMargin = findMargin(estimate.numSamples, winSum, winSquares);
+	}
+	estimate.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	return estimate;
+}
+
+void ScoreEstimator::runWorker(const Job& job, Worker* workers, int index) const
+{
+	long long task = takeTask(workers[index]);
+	while (task >= 0 || (task = stealTasks(workers, numWorkers, index)) >= 0)
+	{
+		playTask(job, task, workers[index]);
+		task = takeTask(workers[index]);
+	}
+}
+
+long long ScoreEstimator::takeTask(Worker& worker)
+{
+	uint64_t range = worker.tasks.load(std::memory_order_relaxed);
+	while (getFirst(range) < getEnd(range))
+	{
+		//Fails if a thief shortened the range in the meantime, in which case range is reloaded
+		if (worker.tasks.compare_exchange_weak(range, range + 1, std::memory_order_relaxed))
+			return getFirst(range);
+	}
+
+	return -1;
+}
+
+long long ScoreEstimator::stealTasks(Worker* workers, int numWorkers, int index)
+{
+	for (int i = 1; i < numWorkers; ++i)
+	{
+		Worker& victim = workers[(index + i) % numWorkers]; //Starting from the next worker spreads the thieves out
+		uint64_t range = victim.tasks.load(std::memory_order_relaxed);
+		while (getFirst(range) < getEnd(range))
+		{
+			uint64_t numStolen = (getEnd(range) - getFirst(range) + 1) / 2; //The last task, if only one is left
+			uint64_t stolenFirst = getEnd(range) - numStolen;
+			if (victim.tasks.compare_exchange_weak(range, makeRange(getFirst(range), stolenFirst), std::memory_order_relaxed))
+			{
+				//Our range is empty, and thieves leave empty ranges alone, so only we can change it
+				workers[index].tasks.store(makeRange(stolenFirst + 1, stolenFirst + numStolen), std::memory_order_relaxed);
+				workers[index].numSteals++;
+				return stolenFirst;
+			}
+		}
+	}
+
+	return -1;
+}
+
+void ScoreEstimator::playTask(const Job& job, long long task, Worker& worker) const
+{
+	MazeRandom random(job.seed ^ (uint64_t(task) * 0x9E3779B97F4A7C15ULL)); //Spread the task numbers over the seeds
+	MazeAgent* agentPtr = job.makeAgent(random.next());
+	MazeOverlay overlay;
+	Player player;
+	int score = 0;
+
+	if (job.mazePtr) //A few games on the shared maze, each a sample
+	{
+		long long numGames = job.numGames - task * GAMES_PER_TASK;
+		if (numGames > GAMES_PER_TASK)
+			numGames = GAMES_PER_TASK;
+
+		for (long long game = 0; game < numGames; ++game)
+		{
+			bool won = playGame(*job.mazePtr, overlay, player, agentPtr, worker, score);
+			worker.numSamples++;
+			worker.scoreSum += score;
+			worker.scoreSquares += double(score) * score;
+			worker.winSum += won;
+			worker.winSquares += won;
+		}
+	}
+	else //Every game on a new maze, whose averages are a sample
+	{
+		MazeInterface* mazePtr = NULL;
+		if (job.level == 1)
+			mazePtr = new MazeLevelOne(job.numNodes, job.balancedLevelOne, random.next());
+		else
+			mazePtr = new MazeLevelTwo(job.numNodes, random.next());
+
+		double scoreSum = 0;
+		long long numWins = 0;
+		for (long long game = 0; game < job.numGames; ++game)
+		{
+			numWins += playGame(*mazePtr, overlay, player, agentPtr, worker, score);
+			scoreSum += score;
+		}
+		delete mazePtr;
+
+		double meanScore = scoreSum / job.numGames;
+		double winRate = double(numWins) / job.numGames;
+		worker.numSamples++;
+		worker.scoreSum += meanScore;
+		worker.scoreSquares += meanScore * meanScore;
+		worker.winSum += winRate;
+		worker.winSquares += winRate * winRate;
+	}
+
+	delete agentPtr;
+}
+
+bool ScoreEstimator::playGame(const MazeInterface& maze, MazeOverlay& overlay, Player& player, MazeAgent* agentPtr,
+		Worker& worker, int& score) const
+{
+	maze.setPlayer(overlay, &player); //Also puts back the prizes of the previous game
+	player.resetNumItems(); //Which Level 2 does not do
+	agentPtr->newMaze(maze.getNumPaths()); //Nothing learned in one game carries over to the next
+
+	bool won = false;
+	bool gameOver = false;
+	int numMoves = 0;
+	while (!gameOver && numMoves < maxMovesPerGame)
+	{
+		int pathIndex = agentPtr->chooseMove();
+		MoveOutcome outcome = maze.makeMove(overlay, pathIndex).outcome;
+		numMoves++;
+
+		if (outcome == MOVE_FINISH)
+		{
+			won = true;
+			gameOver = true;
+		}
+		else if (outcome == MOVE_GAME_OVER)
+		{
+			worker.numGameOvers++;
+			gameOver = true;
+		}
+		agentPtr->moveResult(pathIndex, outcome);
+	}
+
+	if (!gameOver) //Ran out of moves
+		worker.numAbandoned++;
+	worker.numWins += won;
+	worker.numMoves += numMoves;
+	worker.numGames++;
+
+	score = 0;
+	for (int i = 0; i < NUM_COLLECTIBLES; ++i)
+		score += MULTIPLIERS[i] * player.getQuantity(i);
+
+	return won;
+}
@@ -0,0 +1,171 @@
+#ifndef _SCORE_ESTIMATOR_H
+#define _SCORE_ESTIMATOR_H
+
+/*
+This is the class that estimates how well an agent (see MazeAgent) plays: the expected score of a game
+and the probability of reaching the exit, each with a 95% confidence interval. It plays large numbers
+of games on every core, either all on the same maze or over many mazes generated from a seed.
+
+The games are split into tasks: a few games on the shared maze, or all of the games on one generated
+maze. Every worker thread starts with an equal range of the tasks, takes them from the front of its own
+range, and once it runs out steals half of what is left of the range of another worker, so the workers
+stay busy when some games take much longer than others. A range is a single atomic word, so taking and
+stealing a task is a compare-and-swap, and nothing is locked. Every worker adds its results to totals
+of its own, which are only added up once the workers are done.
+
+Each task draws its random numbers (the seed of its agent, and of its maze) from its own generator,
+seeded from the seed of the run and the number of the task, so an estimate only depends on the seed and
+not on the number of workers or on which worker played which task. Every game is played by an agent that
+was just told it is in a new maze, so the games are independent samples.
+
+The shared maze is played through one MazeOverlay per worker (see MazeInterface::setPlayer), so it is
+never copied and never changed.
+*/
+
+#include "MazeAgent.h"
+#include "MazeInterface.h"
+#include "SimulationEngine.h"
+
+#include <atomic>
+#include <stdint.h>
+
+const int GAMES_PER_TASK = 16; //Games played on the shared maze by each task
+const double CONFIDENCE_Z = 1.96; //Normal quantile of the 95% confidence intervals
+
+/*
+The result of a run of the estimator. The intervals are mean +/- margin, found with the normal
+approximation from the spread of the samples: the games when they are all played on the same maze, and
+the average of the games of each maze otherwise, since games on the same maze are not independent.
+*/
+struct ScoreEstimate
+{
+	long long numGames; //Games played
+	long long numWins; //Games where the player reached the exit
+	long long numGameOvers; //Games where the player ran out of lives
+	long long numAbandoned; //Games stopped after the maximum number of moves, counted as lost
+	long long numMoves; //Moves made over all of the games
+	long long numSamples; //Number of samples the intervals are found from, see above
+	double meanScore; //Average score at the end of a game
+	double scoreMargin; //Half the width of the confidence interval of meanScore
+	double winRate; //Fraction of the games that were won
+	double winMargin; //Half the width of the confidence interval of winRate
+	int numWorkers; //Threads that played the games
+	long long numSteals; //Number of times a worker stole tasks from another
+	double seconds; //Time taken by the run
+
+	double getGamesPerSecond() const;
+	double getMovesPerSecond() const;
+};
+
+class ScoreEstimator
+{
+public:
+	/*
+	Returns a new agent, which the estimator deletes once it is done with it. The agent must not share
+	anything with the other agents, since they play on different threads.
+	@param seed: The seed of the agent, for the agents that make random choices.
+	*/
+	typedef MazeAgent* (*AgentMaker)(uint64_t seed);
+
+	/*
+	@param numWorkers: The number of threads playing the games, the calling thread included. With 0,
+	one per core.
+	maxMovesPerGame: The number of moves after which a game that is still going is abandoned.
+	*/
+	ScoreEstimator(int numWorkers = 0, int maxMovesPerGame = DEFAULT_MAX_MOVES_PER_GAME);
+
+	/*
+	Plays numGames games of the maze with agents made by makeAgent. The maze can be played by others
+	while the estimate runs, but must not be changed.
+	@return: The estimate, with one sample per game.
+	*/
+	ScoreEstimate estimate(const MazeInterface& maze, AgentMaker makeAgent, long long numGames, uint64_t seed);
+
+	/*
+	Generates numMazes mazes of the given level and plays gamesPerMaze games on each with agents made by
+	makeAgent. Every maze is built by the worker that plays it, and deleted once its games are played.
+	@param level: 1 or 2, see MazeFactory.
+	numNodes: The number of nodes of the mazes.
+	balancedLevelOne: If true, the Level 1 mazes are built balanced (see MazeLevelOne).
+	@return: The estimate, with one sample per maze, or an estimate of no games if level is neither 1 nor 2.
+	*/
+	ScoreEstimate estimateOverMazes(int level, int numNodes, int numMazes, int gamesPerMaze, AgentMaker makeAgent,
+			uint64_t seed, bool balancedLevelOne = true);
+
+	int getNumWorkers() const;
+
+private:
+	/*
+	The tasks and results of one worker. The range of tasks left is kept in a single word, the first
+	task in the lower 32 bits and the end in the upper 32 bits, so that it is taken from and stolen from
+	with a compare-and-swap. The padding keeps the workers on different cache lines.
+	*/
+	struct Worker
+	{
+		char padding[64];
+		std::atomic<uint64_t> tasks;
+		char morePadding[64];
+		long long numGames;
+		long long numWins;
+		long long numGameOvers;
+		long long numAbandoned;
+		long long numMoves;
+		long long numSamples;
+		double scoreSum; //Sums of the samples and of their squares, see ScoreEstimate
+		double scoreSquares;
+		double winSum;
+		double winSquares;
+		long long numSteals;
+	};
+
+	/*
+	What the workers of a run share, none of which changes during the run.
+	*/
+	struct Job
+	{
+		const MazeInterface* mazePtr; //The shared maze, NULL when the mazes are generated
+		int level; //Level, number of nodes and shape of the generated mazes
+		int numNodes;
+		bool balancedLevelOne;
+		long long numGames; //Games played on the shared maze, or on each generated maze
+		AgentMaker makeAgent;
+		uint64_t seed;
+	};
+
+	int numWorkers; //Number of threads playing the games
+	int maxMovesPerGame; //Number of moves after which a game is abandoned
+
+	/*
+	Splits numTasks tasks between the workers, runs them and adds up the results.
+	*/
+	ScoreEstimate run(const Job& job, long long numTasks);
+
+	/*
+	The loop run by each worker, until no worker has tasks left.
+	*/
+	void runWorker(const Job& job, Worker* workers, int index) const;
+
+	/*
+	takeTask takes the first task of the range of worker. stealTasks looks through the other workers for
+	one with tasks left, moves half of them to the range of workers[index], and takes the first of them.
+	@return: The task, or -1 if there was none to take.
+	*/
+	static long long takeTask(Worker& worker);
+	static long long stealTasks(Worker* workers, int numWorkers, int index);
+
+	/*
+	Plays task number task and adds its results to worker.
+	*/
+	void playTask(const Job& job, long long task, Worker& worker) const;
+
+	/*
+	Plays a game of maze with agentPtr, moving player through overlay, and adds it to the totals of
+	worker, but not to its samples.
+	@post: score is the score of the player at the end of the game.
+	@return: True if the player reached the exit.
+	*/
+	bool playGame(const MazeInterface& maze, MazeOverlay& overlay, Player& player, MazeAgent* agentPtr, Worker& worker,
+			int& score) const;
+};
+
+#endif
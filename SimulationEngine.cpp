@@ -0,0 +1,88 @@
+/*
+This is the implementation file corresponding to SimulationEngine.h containing the definitions of the member functions.
+*/
+
+#include "SimulationEngine.h"
+
+#include <chrono>
+
+double SimulationStats::getGamesPerSecond() const
+{
+	return (seconds > 0 ? numGames / seconds : 0);
+}
+
+double SimulationStats::getMovesPerSecond() const
+{
+	return (seconds > 0 ? numMoves / seconds : 0);
+}
+
+double SimulationStats::getWinRate() const
+{
+	return (numGames > 0 ? double(numWins) / numGames : 0);
+}
+
+double SimulationStats::getLifeLossRate() const
+{
+	return (numMoves > 0 ? double(numLivesLost) / numMoves : 0);
+}
+
+double SimulationStats::getLivesLostPerGame() const
+{
+	return (numGames > 0 ? double(numLivesLost) / numGames : 0);
+}
+
+SimulationEngine::SimulationEngine(int maxMovesPerGame) : maxMovesPerGame(maxMovesPerGame)
+{
+}
+
+SimulationStats SimulationEngine::run(MazeInterface* mazePtr, MazeAgent* agentPtr, int numGames)
+{
+	SimulationStats stats = {0, 0, 0, 0, 0, 0, 0};
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	mazePtr->setPlayer(&player);
+	agentPtr->newMaze(mazePtr->getNumPaths());
+
+	for (int game = 0; game < numGames; ++game)
+	{
+		mazePtr->startOver(); //Back to the start, with the prizes and the lives reset
+		agentPtr->startGame();
+
+		bool gameOver = false;
+		int numMoves = 0;
+		while (!gameOver && numMoves < maxMovesPerGame)
+		{
+			int pathIndex = agentPtr->chooseMove();
+			MoveEvent event = mazePtr->makeMove(pathIndex);
+			numMoves++;
+
+			switch (event.outcome)
+			{
+				case MOVE_FINISH:
+					stats.numWins++;
+					gameOver = true;
+					break;
+				case MOVE_GAME_OVER:
+					stats.numGameOvers++;
+					stats.numLivesLost++;
+					gameOver = true;
+					break;
+				case MOVE_DEAD_END:
+					stats.numLivesLost++;
+					break;
+				default: //The player either moved or stayed where they were
+					break;
+			}
+			agentPtr->moveResult(pathIndex, event.outcome);
+		}
+
+		if (!gameOver) //Ran out of moves
+			stats.numAbandoned++;
+		stats.numMoves += numMoves;
+		stats.numGames++;
+	}
+
+	stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	return stats;
+}
@@ -0,0 +1,62 @@
+#ifndef _SIMULATION_ENGINE_H
+#define _SIMULATION_ENGINE_H
+
+/*
+This is the headless engine that plays the maze with an agent (see MazeAgent) instead of a person, so
+that large numbers of games can be run for balancing and regression tests without a terminal.
+
+The moves are made with MazeInterface::makeMove, so nothing is printed and the outcome of every move is
+passed straight on to the agent.
+*/
+
+#include "MazeAgent.h"
+#include "MazeInterface.h"
+#include "Player.h"
+
+const int DEFAULT_MAX_MOVES_PER_GAME = 100000; //Games still going after this many moves are abandoned
+
+/*
+The totals of a run of the engine, along with the rates derived from them.
+*/
+struct SimulationStats
+{
+	long long numGames; //Games played
+	long long numWins; //Games where the player reached the exit
+	long long numGameOvers; //Games where the player ran out of lives
+	long long numAbandoned; //Games stopped after the maximum number of moves
+	long long numMoves; //Moves made over all of the games
+	long long numLivesLost; //Dead ends hit over all of the games
+	double seconds; //Time taken by the run
+
+	double getGamesPerSecond() const;
+	double getMovesPerSecond() const;
+	double getWinRate() const; //Fraction of the games that were won
+	double getLifeLossRate() const; //Fraction of the moves that hit a dead end
+	double getLivesLostPerGame() const;
+};
+
+class SimulationEngine
+{
+public:
+	/*
+	@param maxMovesPerGame: Number of moves after which a game that is still going is abandoned, so
+	that agents that never find the exit cannot run forever.
+	*/
+	SimulationEngine(int maxMovesPerGame = DEFAULT_MAX_MOVES_PER_GAME);
+
+	/*
+	Plays numGames games of the maze with the agent, starting the maze over before every game.
+	The agent is told it is in a new maze once, before the first game, so what it learns carries over
+	from one game to the next.
+	@post: The player of the engine is the player of the maze. The maze must be given another player
+	with setPlayer before it is used once the engine is destroyed.
+	@return: The totals of the run.
+	*/
+	SimulationStats run(MazeInterface* mazePtr, MazeAgent* agentPtr, int numGames);
+
+private:
+	Player player; //Player moved around by the agents
+	int maxMovesPerGame; //Number of moves after which a game is abandoned
+};
+
+#endif
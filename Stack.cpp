@@ -6,82 +6,144 @@ Implementation file corresponding to Stack.h, containing the definitions of the
 */
 
 #include "Stack.h"
+
 #include <cassert>
+#include <new>
+#include <utility>
+
+template <class ItemType, int INLINE_SIZE>
+Stack<ItemType, INLINE_SIZE>::Stack()
+	: items(reinterpret_cast<ItemType*>(inlineItems)), capacity(INLINE_SIZE), numItems(0)
+{
+}
 
-template <class ItemType>
-Stack<ItemType>::Stack() : topPtr(NULL)
+template <class ItemType, int INLINE_SIZE>
+Stack<ItemType, INLINE_SIZE>::Stack(const Stack& otherStack)
+	: items(reinterpret_cast<ItemType*>(inlineItems)), capacity(INLINE_SIZE), numItems(0)
 {
+	copyFrom(otherStack);
+}
+
+template <class ItemType, int INLINE_SIZE>
+Stack<ItemType, INLINE_SIZE>::~Stack()
+{
+	while (pop()); //Destroy the contents of the stack
+
+	if (items != reinterpret_cast<ItemType*>(inlineItems)) //Free the heap buffer if we have one
+		::operator delete(items);
 }
 
-template <class ItemType>
-Stack<ItemType>::Stack(const Stack& otherStack)
+template <class ItemType, int INLINE_SIZE>
+Stack<ItemType, INLINE_SIZE>& Stack<ItemType, INLINE_SIZE>::operator=(const Stack& otherStack)
 {
-	topPtr = NULL;
-	if (otherStack.topPtr) //Copy contents of the other stack
+	if (this != &otherStack)
 	{
-		topPtr = new Node<ItemType>(otherStack.topPtr->getItem());
+		while (pop()); //Keep our buffer, but empty it before copying
+		copyFrom(otherStack);
+	}
+
+	return *this;
+}
 
-		Node<ItemType>* otherCurrent = otherStack.topPtr->getNext();
-		Node<ItemType>* storeFirstPtr = topPtr;
+template <class ItemType, int INLINE_SIZE>
+void Stack<ItemType, INLINE_SIZE>::copyFrom(const Stack& otherStack)
+{
+	reserve(otherStack.numItems); //A single allocation at most, then copy the items bottom first
+	for (int i = 0; i < otherStack.numItems; ++i)
+		new (items + i) ItemType(otherStack.items[i]);
+	numItems = otherStack.numItems;
+}
 
-		while (otherCurrent)
-		{
-			topPtr->setNext(new Node<ItemType>(otherCurrent->getItem()));
-			topPtr = topPtr->getNext();
-			otherCurrent = otherCurrent->getNext();
-		}
+template <class ItemType, int INLINE_SIZE>
+void Stack<ItemType, INLINE_SIZE>::grow(int newCapacity)
+{
+	moveItems(static_cast<ItemType*>(::operator new(sizeof(ItemType) * newCapacity)), newCapacity);
+}
 
-		topPtr->setNext(NULL);
-		topPtr = storeFirstPtr;
+template <class ItemType, int INLINE_SIZE>
+void Stack<ItemType, INLINE_SIZE>::moveItems(ItemType* newItems, int newCapacity)
+{
+	for (int i = 0; i < numItems; ++i) //Move the items over to the new buffer
+	{
+		new (newItems + i) ItemType(std::move(items[i]));
+		items[i].~ItemType();
 	}
+
+	if (items != reinterpret_cast<ItemType*>(inlineItems))
+		::operator delete(items);
+
+	items = newItems;
+	capacity = newCapacity;
 }
 
-template <class ItemType>
-Stack<ItemType>::~Stack()
+template <class ItemType, int INLINE_SIZE>
+void Stack<ItemType, INLINE_SIZE>::reserve(int minCapacity)
 {
-	while (topPtr) //Delete contents of the stack
+	if (minCapacity > capacity) //Only ever grow the buffer
 	{
-		Node<ItemType>* storeNext = topPtr->getNext();
-		delete topPtr;
-		topPtr = storeNext;
+		int newCapacity = capacity;
+		while (newCapacity < minCapacity)
+			newCapacity *= 2;
+		grow(newCapacity);
 	}
 }
 
-template <class ItemType>
-bool Stack<ItemType>::empty() const
+template <class ItemType, int INLINE_SIZE>
+bool Stack<ItemType, INLINE_SIZE>::empty() const
+{
+	return (numItems == 0);
+}
+
+template <class ItemType, int INLINE_SIZE>
+int Stack<ItemType, INLINE_SIZE>::size() const
 {
-	return (!topPtr);
+	return numItems;
 }
 
-template <class ItemType>
-bool Stack<ItemType>::push(const ItemType& item)
+template <class ItemType, int INLINE_SIZE>
+bool Stack<ItemType, INLINE_SIZE>::push(const ItemType& item)
 {
-	Node<ItemType>* prev = topPtr; //Store previous top of the stack and insert item on top
-	topPtr = new Node<ItemType>(item);
-	topPtr->setNext(prev);
+	return emplace(item);
+}
+
+template <class ItemType, int INLINE_SIZE>
+bool Stack<ItemType, INLINE_SIZE>::push(ItemType&& item)
+{
+	return emplace(std::move(item));
+}
+
+template <class ItemType, int INLINE_SIZE>
+template <class... Args>
+bool Stack<ItemType, INLINE_SIZE>::emplace(Args&&... args)
+{
+	if (numItems == capacity) //Out of room, so we double the capacity. args may refer to an item of the
+	{				//stack, so the new item is constructed before the old ones are moved
+		ItemType* newItems = static_cast<ItemType*>(::operator new(sizeof(ItemType) * 2*capacity));
+		new (newItems + numItems) ItemType(std::forward<Args>(args)...);
+		moveItems(newItems, 2*capacity);
+	}
+	else
+		new (items + numItems) ItemType(std::forward<Args>(args)...);
+	numItems++;
 
 	return true;
 }
 
-template <class ItemType>
-bool Stack<ItemType>::pop()
+template <class ItemType, int INLINE_SIZE>
+bool Stack<ItemType, INLINE_SIZE>::pop()
 {
 	bool ableToPop = !empty();
 	if (ableToPop) //Pops top of the stack if it is nonempty.
-	{
-		Node<ItemType>* storeNext = topPtr->getNext();
-		delete topPtr;
-		topPtr = storeNext;
-	}
+		items[--numItems].~ItemType();
 
 	return ableToPop;
 }
 
-template <class ItemType>
-ItemType Stack<ItemType>::top() const
+template <class ItemType, int INLINE_SIZE>
+const ItemType& Stack<ItemType, INLINE_SIZE>::top() const
 {
 	assert(!empty()); //Terminates program if top() is called with an empty stack.
-	return topPtr->getItem();
+	return items[numItems - 1];
 }
 
 #endif
@@ -2,13 +2,15 @@
 #define _STACK_H
 
 /*
-Stack class, implemented as a chain of linked nodes.
+Stack class, implemented as a contiguous, growable array. The first INLINE_SIZE items are stored inside
+the stack object itself, so small stacks never touch the heap. Once the stack grows past that, the items
+are moved to a heap buffer that doubles in size whenever it fills up.
 Contains the relevant functions for a stack object.
 */
 
-#include "Node.h"
+const int DEFAULT_STACK_INLINE_SIZE = 32; //Default number of items stored inside the stack object
 
-template <class ItemType>
+template <class ItemType, int INLINE_SIZE = DEFAULT_STACK_INLINE_SIZE>
 class Stack
 {
 public:
@@ -16,13 +18,39 @@ public:
 	Stack(const Stack&); //Copy constructor
 	~Stack();
 
+	Stack& operator=(const Stack&);
+
 	bool empty() const; //Checks if stack is empty
+	int size() const; //Returns the number of items on the stack
 	bool push(const ItemType& item); //Pushes an item onto the stack
+	bool push(ItemType&& item); //Moves an item onto the stack
+
+	/*
+	Constructs a new item in place on top of the stack, passing args to the ItemType constructor.
+	*/
+	template <class... Args>
+	bool emplace(Args&&... args);
+
 	bool pop(); //Pops the stack
-	ItemType top() const; //Returns the item at the top of the stack if it is nonempty, otherwise program
+	const ItemType& top() const; //Returns the item at the top of the stack if it is nonempty, otherwise program
 				//terminates.
+
+	/*
+	Makes sure the stack can hold at least minCapacity items without reallocating.
+	@post: The capacity of the stack is at least minCapacity.
+	*/
+	void reserve(int minCapacity);
+
 private:
-	Node<ItemType>* topPtr; //Pointer to the top of the stack
+	alignas(ItemType) char inlineItems[INLINE_SIZE * sizeof(ItemType)]; //Storage for the first INLINE_SIZE items
+	ItemType* items; //Points to inlineItems, or to a heap buffer once the stack outgrows it
+	int capacity; //Number of items that fit into items
+	int numItems; //Number of items on the stack. items[numItems - 1] is the top
+
+	void grow(int newCapacity); //Moves the items into a heap buffer having newCapacity slots
+	void moveItems(ItemType* newItems, int newCapacity); //Moves the items into newItems, a heap buffer having
+								//newCapacity slots, and frees the old buffer
+	void copyFrom(const Stack&); //Pushes the items of the other stack, bottom first
 };
 
 #include "Stack.cpp"
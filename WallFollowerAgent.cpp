@@ -0,0 +1,53 @@
+/*
+This is the implementation file corresponding to WallFollowerAgent.h containing the definitions of the member functions.
+*/
+
+#include "WallFollowerAgent.h"
+
+WallFollowerAgent::WallFollowerAgent() : numPaths(1), nextDirection(1)
+{
+}
+
+void WallFollowerAgent::newMaze(int numPaths)
+{
+	this->numPaths = numPaths;
+	startGame();
+}
+
+void WallFollowerAgent::startGame()
+{
+	while (pathTaken.pop()); //Back at the start, with no direction tried yet
+	nextDirection = 1;
+}
+
+int WallFollowerAgent::chooseMove()
+{
+	if (nextDirection < numPaths) //Try the next direction of the intersection
+		return nextDirection;
+	else if (pathTaken.empty()) //Tried everything from the start, so go around again
+		return (nextDirection = 1);
+	else //Every direction has been tried, so we go back
+		return 0;
+}
+
+void WallFollowerAgent::moveResult(int pathIndex, MoveOutcome outcome)
+{
+	if (outcome == MOVE_SUCCESSFUL)
+	{
+		if (pathIndex == 0) //Came back, so continue with the direction after the one we came back from
+		{
+			if (!pathTaken.empty())
+			{
+				nextDirection = pathTaken.top() + 1;
+				pathTaken.pop();
+			}
+		}
+		else //New intersection, start trying its directions
+		{
+			pathTaken.push(pathIndex);
+			nextDirection = 1;
+		}
+	}
+	else if (outcome == MOVE_DEAD_END) //Try the next direction instead
+		nextDirection = pathIndex + 1;
+}
@@ -0,0 +1,32 @@
+#ifndef _WALL_FOLLOWER_AGENT_H
+#define _WALL_FOLLOWER_AGENT_H
+
+/*
+Agent that keeps its hand on the wall: at every intersection it tries the directions in order, starting
+with the first one after backwards, and goes back once all of them have been tried. Since the mazes are
+trees, this walks every intersection of the maze until it finds the exit, much like following a wall.
+
+To know which direction to try after coming back to an intersection, the agent keeps the directions it
+took from the start. It remembers nothing else, so every game is played the same way.
+*/
+
+#include "MazeAgent.h"
+#include "Stack.h"
+
+class WallFollowerAgent : public MazeAgent
+{
+public:
+	WallFollowerAgent();
+
+	void newMaze(int numPaths); //Described in MazeAgent
+	void startGame(); //Described in MazeAgent
+	int chooseMove(); //Described in MazeAgent
+	void moveResult(int pathIndex, MoveOutcome outcome); //Described in MazeAgent
+
+private:
+	int numPaths; //Number of directions of the maze
+	int nextDirection; //Next direction to try at the current intersection
+	Stack<int> pathTaken; //Directions taken from the start to the current intersection
+};
+
+#endif
@@ -0,0 +1,130 @@
+/*
+Benchmark comparing three ways of moving many simulated players through the same maze in lockstep:
+one makeMove call per player, each player having their own MazeOverlay, and BatchSimulator moving
+them one at a time and eight at a time with AVX2. Every way plays the same random moves, and a player
+starts over as soon as their game ends, so that they keep moving for the whole run.
+
+Build with "make bench" and run ./batchBenchmark [players] [steps] [nodes].
+*/
+
+#include "BatchSimulator.h"
+#include "MazeLevelOne.h"
+#include "MazeLevelTwo.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+const int DEFAULT_NUM_PLAYERS = 4096;
+const int DEFAULT_NUM_STEPS = 1000; //Moves made by each player
+const int DEFAULT_NUM_NODES = 100000; //Number of nodes of the mazes
+const uint64_t MAZE_SEED = 2015; //Mazes and moves are seeded so that runs are comparable
+
+/*
+Fills pathIndices with numSteps moves for each of numPlayers players, step after step. Some of the
+moves are out of range, to time the invalid ones too.
+*/
+void makeMoves(int* pathIndices, int numPlayers, int numSteps, int numPaths)
+{
+	MazeRandom random(MAZE_SEED);
+	for (long long i = 0; i < static_cast<long long>(numPlayers) * numSteps; ++i)
+		pathIndices[i] = random.nextInt(numPaths + 1) - (random.nextInt(64) == 0); //Rarely -1 or numPaths
+}
+
+/*
+Returns the number of moves per second made with one makeMove per player.
+*/
+double timeOverlays(const MazeInterface& maze, const int* pathIndices, int numPlayers, int numSteps)
+{
+	Player* players = new Player[numPlayers];
+	MazeOverlay* overlays = new MazeOverlay[numPlayers];
+	for (int i = 0; i < numPlayers; ++i)
+		maze.setPlayer(overlays[i], &players[i]);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int step = 0; step < numSteps; ++step)
+	{
+		const int* stepIndices = pathIndices + static_cast<long long>(step) * numPlayers;
+		for (int i = 0; i < numPlayers; ++i)
+		{
+			MoveOutcome outcome = maze.makeMove(overlays[i], stepIndices[i]).outcome;
+			if (outcome == MOVE_FINISH || outcome == MOVE_GAME_OVER)
+				maze.startOver(overlays[i]);
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	delete [] overlays;
+	delete [] players;
+	return static_cast<double>(numPlayers) * numSteps / seconds;
+}
+
+/*
+Returns the number of moves per second made with BatchSimulator, vectorized or not.
+*/
+double timeBatch(const MazeInterface& maze, const int* pathIndices, int numPlayers, int numSteps, bool vectorized)
+{
+	BatchSimulator simulator(maze, numPlayers);
+	simulator.setVectorized(vectorized);
+	MoveOutcome* outcomes = new MoveOutcome[numPlayers];
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int step = 0; step < numSteps; ++step)
+	{
+		simulator.step(pathIndices + static_cast<long long>(step) * numPlayers, outcomes);
+		for (int i = 0; i < numPlayers; ++i)
+		{
+			if (outcomes[i] == MOVE_FINISH || outcomes[i] == MOVE_GAME_OVER)
+				simulator.startOver(i);
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	delete [] outcomes;
+	return static_cast<double>(numPlayers) * numSteps / seconds;
+}
+
+/*
+Times the three ways on the maze and prints a row.
+*/
+void runLevel(const char* level, const MazeInterface& maze, int numPlayers, int numSteps)
+{
+	int* pathIndices = new int[static_cast<long long>(numPlayers) * numSteps];
+	makeMoves(pathIndices, numPlayers, numSteps, maze.getNumPaths());
+
+	double overlayRate = timeOverlays(maze, pathIndices, numPlayers, numSteps);
+	double scalarRate = timeBatch(maze, pathIndices, numPlayers, numSteps, false);
+	std::cout << std::setw(7) << level << std::fixed << std::setprecision(0) << std::setw(16) << overlayRate
+		<< std::setw(16) << scalarRate;
+	if (BatchSimulator::hasAvx2())
+	{
+		double vectorRate = timeBatch(maze, pathIndices, numPlayers, numSteps, true);
+		std::cout << std::setw(16) << vectorRate << std::setw(11) << std::setprecision(2)
+			<< vectorRate / overlayRate << "x";
+	}
+	else
+		std::cout << std::setw(16) << "no AVX2";
+	std::cout << std::endl;
+
+	delete [] pathIndices;
+}
+
+int main(int argc, char* argv[])
+{
+	int numPlayers = (argc > 1 ? atoi(argv[1]) : DEFAULT_NUM_PLAYERS);
+	int numSteps = (argc > 2 ? atoi(argv[2]) : DEFAULT_NUM_STEPS);
+	int numNodes = (argc > 3 ? atoi(argv[3]) : DEFAULT_NUM_NODES);
+
+	std::cout << numPlayers << " players, " << numSteps << " steps, " << numNodes << " nodes (moves/sec)" << std::endl;
+	std::cout << std::setw(7) << "level" << std::setw(16) << "makeMove" << std::setw(16) << "batch scalar"
+		<< std::setw(16) << "batch AVX2" << std::setw(12) << "speedup" << std::endl;
+
+	MazeLevelOne levelOne(numNodes, true, MAZE_SEED); //Balanced, the plain BST is too slow to build at this size
+	runLevel("one", levelOne, numPlayers, numSteps);
+
+	MazeLevelTwo levelTwo(numNodes, MAZE_SEED);
+	runLevel("two", levelTwo, numPlayers, numSteps);
+
+	return 0;
+}
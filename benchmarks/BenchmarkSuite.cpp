@@ -0,0 +1,468 @@
+/*
+Benchmark suite timing the operations of both maze levels over a sweep of maze sizes, along with the
+push and pop throughput of Queue and Stack, so that results can be tracked from one version to the next.
+
+For every level and size, the maze is built from a fixed seed and the following are timed: building
+the maze, movePlayer, makeMove, reveal, startOver after a session of random moves, the copy constructor,
+displayMaze and destroying the maze. Everything that prints writes to /dev/null while it is timed, so
+the formatting is measured but not the terminal. Level 1 mazes are balanced, since a plain BST of these
+sizes takes too long to build. The Level 1 display is as wide as 2^height characters, so it is only
+timed for the smallest sizes.
+
+Each operation is repeated until it has run for at least MIN_MEASURE_MILLIS, with at least one run, so
+small sizes are averaged over many runs while the largest ones are timed once.
+
+Before timing Queue and Stack, the suite checks that pushing their own front or top pushes a copy of
+it, even when the container has to grow for it, and fails if it does not.
+
+Build with "make suite" (or "make bench") and run
+	./benchmarkSuite [--csv | --json] [--max-nodes N]
+The results are written to standard output as CSV (the default) or JSON, and the progress to standard
+error, e.g. ./benchmarkSuite --json > results.json. Sizes go from 10^3 to 10^7 nodes, or up to N.
+*/
+
+#include "MazeLevelOne.h"
+#include "MazeLevelTwo.h"
+#include "Queue.h"
+#include "Stack.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+const int NUM_SIZES = 5;
+const int MAZE_SIZES[NUM_SIZES] = {1000, 10000, 100000, 1000000, 10000000};
+const uint64_t MAZE_SEED = 2015; //Mazes are generated from a fixed seed so that runs are comparable
+const double MIN_MEASURE_MILLIS = 200; //Every operation is repeated for at least this long
+const int NUM_MOVES = 100000; //Moves per round of the movePlayer, makeMove and reveal timings
+const int MOVES_PER_SESSION = 200; //Random moves played before each timed startOver
+const int MAX_LEVEL_ONE_DISPLAY_NODES = 1000; //Larger Level 1 displays are too wide to print
+const int MAX_RESULTS = 128;
+const int MAX_SELF_PUSH_ITEMS = 200; //Containers of up to this many items push their own front or top
+
+/*
+One row of the results: the operation, the level it ran on ("one", "two", or "" for the containers),
+the size of the maze or container, how many times the operation ran and how long that took in total.
+*/
+struct BenchmarkResult
+{
+	const char* operation;
+	const char* level;
+	int size;
+	long long iterations;
+	double totalMillis;
+};
+
+BenchmarkResult results[MAX_RESULTS];
+int numResults = 0;
+
+/*
+Returns the number of milliseconds since start.
+*/
+double millisSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+Adds a row to the results, and shows it on standard error as progress.
+*/
+void addResult(const char* operation, const char* level, int size, long long iterations, double totalMillis)
+{
+	if (numResults < MAX_RESULTS)
+	{
+		BenchmarkResult& result = results[numResults++];
+		result.operation = operation;
+		result.level = level;
+		result.size = size;
+		result.iterations = iterations;
+		result.totalMillis = totalMillis;
+	}
+
+	std::cerr << operation << " " << level << " " << size << ": " << totalMillis * 1000000 / iterations << " ns" << std::endl;
+}
+
+/*
+Sends the output of std::cout to /dev/null for as long as the object lives.
+*/
+class SilenceOutput
+{
+public:
+	SilenceOutput() : nullFile("/dev/null"), oldBuffer(std::cout.rdbuf(nullFile.rdbuf())) {}
+	~SilenceOutput() { std::cout.rdbuf(oldBuffer); }
+
+private:
+	std::ofstream nullFile;
+	std::streambuf* oldBuffer;
+};
+
+/*
+Builds the maze of the given level from MAZE_SEED. Level 1 mazes are balanced.
+*/
+MazeLevelOne* newMaze(const MazeLevelOne*, int numNodes)
+{
+	return new MazeLevelOne(numNodes, true, MAZE_SEED);
+}
+
+MazeLevelTwo* newMaze(const MazeLevelTwo*, int numNodes)
+{
+	return new MazeLevelTwo(numNodes, MAZE_SEED);
+}
+
+/*
+Times building and destroying the maze, repeatedly.
+@return: The last maze built, which the caller deletes.
+*/
+template <class MazeType>
+MazeType* benchmarkBuild(const char* level, int numNodes)
+{
+	double buildMillis = 0, destroyMillis = 0;
+	int iterations = 0;
+	MazeType* mazePtr = NULL;
+	do
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		MazeType* newMazePtr = newMaze(mazePtr, numNodes);
+		buildMillis += millisSince(start);
+
+		if (mazePtr)
+		{
+			start = std::chrono::steady_clock::now();
+			delete mazePtr;
+			destroyMillis += millisSince(start);
+		}
+		mazePtr = newMazePtr;
+		iterations++;
+	} while (buildMillis + destroyMillis < MIN_MEASURE_MILLIS);
+
+	addResult("build", level, numNodes, iterations, buildMillis);
+	if (iterations == 1) //Nothing was destroyed yet, so we time destroying a copy of the maze
+	{
+		MazeType* copyPtr = new MazeType(*mazePtr);
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		delete copyPtr;
+		destroyMillis = millisSince(start);
+		iterations = 2;
+	}
+	addResult("destroy", level, numNodes, iterations - 1, destroyMillis);
+
+	return mazePtr;
+}
+
+/*
+Times the moves of the player, with movePlayer (which prints) and with makeMove. The same random moves
+are played for both, starting over whenever a game ends.
+*/
+void benchmarkMoves(MazeInterface* mazePtr, Player* playerPtr, const char* level, int numNodes)
+{
+	int* pathIndices = new int[NUM_MOVES];
+	MazeRandom random(MAZE_SEED);
+	for (int i = 0; i < NUM_MOVES; ++i)
+		pathIndices[i] = random.nextInt(mazePtr->getNumPaths());
+
+	double totalMillis = 0;
+	long long iterations = 0;
+	mazePtr->setPlayer(playerPtr);
+	{
+		SilenceOutput silence;
+		do
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (int i = 0; i < NUM_MOVES; ++i)
+			{
+				if (mazePtr->movePlayer(pathIndices[i]) != 0) //Reached the finish or game over
+					mazePtr->startOver();
+			}
+			totalMillis += millisSince(start);
+			iterations += NUM_MOVES;
+		} while (totalMillis < MIN_MEASURE_MILLIS);
+	}
+	addResult("movePlayer", level, numNodes, iterations, totalMillis);
+
+	totalMillis = 0;
+	iterations = 0;
+	mazePtr->startOver();
+	do
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int i = 0; i < NUM_MOVES; ++i)
+		{
+			MoveOutcome outcome = mazePtr->makeMove(pathIndices[i]).outcome;
+			if (outcome == MOVE_FINISH || outcome == MOVE_GAME_OVER)
+				mazePtr->startOver();
+		}
+		totalMillis += millisSince(start);
+		iterations += NUM_MOVES;
+	} while (totalMillis < MIN_MEASURE_MILLIS);
+	addResult("makeMove", level, numNodes, iterations, totalMillis);
+
+	delete [] pathIndices;
+}
+
+/*
+Times reveal, giving the player a power before every call so that the hint is always printed.
+*/
+void benchmarkReveal(MazeInterface* mazePtr, Player* playerPtr, const char* level, int numNodes)
+{
+	double totalMillis = 0;
+	long long iterations = 0;
+	mazePtr->setPlayer(playerPtr);
+	mazePtr->startOver();
+	SilenceOutput silence;
+	do
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int i = 0; i < NUM_MOVES; ++i)
+		{
+			playerPtr->incrementQuantity(2);
+			mazePtr->reveal();
+		}
+		totalMillis += millisSince(start);
+		iterations += NUM_MOVES;
+	} while (totalMillis < MIN_MEASURE_MILLIS);
+	addResult("reveal", level, numNodes, iterations, totalMillis);
+}
+
+/*
+Times startOver, each reset being preceded by a session of MOVES_PER_SESSION random moves which is
+not timed.
+*/
+void benchmarkStartOver(MazeInterface* mazePtr, Player* playerPtr, const char* level, int numNodes)
+{
+	int pathIndices[MOVES_PER_SESSION];
+	MoveEvent events[MOVES_PER_SESSION];
+	MazeRandom random(MAZE_SEED);
+
+	double totalMillis = 0;
+	long long iterations = 0;
+	mazePtr->setPlayer(playerPtr);
+	do
+	{
+		for (int i = 0; i < MOVES_PER_SESSION; ++i)
+			pathIndices[i] = random.nextInt(mazePtr->getNumPaths());
+		mazePtr->makeMoves(pathIndices, MOVES_PER_SESSION, events);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		mazePtr->startOver();
+		totalMillis += millisSince(start);
+		iterations++;
+	} while (totalMillis < MIN_MEASURE_MILLIS && iterations < NUM_MOVES);
+	addResult("startOver", level, numNodes, iterations, totalMillis);
+}
+
+/*
+Times the copy constructor. The copies are deleted outside of the timing.
+*/
+template <class MazeType>
+void benchmarkCopy(const MazeType& maze, const char* level, int numNodes)
+{
+	double totalMillis = 0;
+	long long iterations = 0;
+	do
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		MazeType* copyPtr = new MazeType(maze);
+		totalMillis += millisSince(start);
+		iterations++;
+		delete copyPtr;
+	} while (totalMillis < MIN_MEASURE_MILLIS);
+	addResult("copy", level, numNodes, iterations, totalMillis);
+}
+
+/*
+Times displayMaze, with the player at the start of the maze.
+*/
+void benchmarkDisplay(MazeInterface* mazePtr, const char* level, int numNodes)
+{
+	double totalMillis = 0;
+	long long iterations = 0;
+	mazePtr->startOver();
+	SilenceOutput silence;
+	do
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		mazePtr->displayMaze();
+		totalMillis += millisSince(start);
+		iterations++;
+	} while (totalMillis < MIN_MEASURE_MILLIS);
+	addResult("displayMaze", level, numNodes, iterations, totalMillis);
+}
+
+/*
+Runs every maze benchmark on a maze of the given level and size.
+*/
+template <class MazeType>
+void benchmarkLevel(const char* level, int numNodes, bool timeDisplay)
+{
+	MazeType* mazePtr = benchmarkBuild<MazeType>(level, numNodes);
+	Player player;
+
+	benchmarkMoves(mazePtr, &player, level, numNodes);
+	benchmarkReveal(mazePtr, &player, level, numNodes);
+	benchmarkStartOver(mazePtr, &player, level, numNodes);
+	benchmarkCopy(*mazePtr, level, numNodes);
+	if (timeDisplay)
+		benchmarkDisplay(mazePtr, level, numNodes);
+
+	delete mazePtr;
+}
+
+/*
+Times pushing numItems items into an empty container and popping them all, repeatedly. Queue is first
+in, first out and Stack last in, first out, but both have push and pop, so one template serves both.
+The container is created for every round, so growing its buffer is part of the time.
+*/
+template <class ContainerType>
+void benchmarkContainer(const char* operation, int numItems)
+{
+	double totalMillis = 0;
+	long long iterations = 0;
+	long long checksum = 0; //Keeps the compiler from optimizing the items away
+	do
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		{
+			ContainerType container;
+			for (int i = 0; i < numItems; ++i)
+				container.push(i);
+			while (!container.empty())
+			{
+				checksum += container.size();
+				container.pop();
+			}
+		}
+		totalMillis += millisSince(start);
+		iterations += 2LL * numItems; //One push and one pop per item
+	} while (totalMillis < MIN_MEASURE_MILLIS);
+
+	if (checksum == 0) //Never true, every round pops at least one item
+		std::cerr << "No items were popped" << std::endl;
+	addResult(operation, "", numItems, iterations, totalMillis);
+}
+
+/*
+Returns the item that the next pop removes.
+*/
+template <class ItemType>
+const ItemType& peek(const Queue<ItemType>& queue)
+{
+	return queue.front();
+}
+
+template <class ItemType, int INLINE_SIZE>
+const ItemType& peek(const Stack<ItemType, INLINE_SIZE>& stack)
+{
+	return stack.top();
+}
+
+/*
+Returns true if pushing the item that the next pop would remove pushes a copy of it, for containers of
+1 to maxItems items, so that some of them have to grow for it. The items are different strings, long
+enough to be on the heap, so an item that was moved from or freed before it was copied is noticed.
+*/
+template <class ContainerType>
+bool checkSelfPush(int maxItems)
+{
+	bool pushedCopy = true;
+	for (int numItems = 1; numItems <= maxItems && pushedCopy; ++numItems)
+	{
+		ContainerType container;
+		for (int i = 0; i < numItems; ++i)
+			container.push(std::to_string(i) + std::string(32, '.'));
+
+		std::string item = peek(container);
+		container.push(peek(container));
+
+		int numCopies = 0; //The item, and the copy that was pushed
+		int numPopped = 0;
+		for (; !container.empty(); container.pop(), ++numPopped)
+			numCopies += (peek(container) == item);
+		pushedCopy = (numCopies == 2 && numPopped == numItems + 1);
+	}
+
+	return pushedCopy;
+}
+
+/*
+Writes the results to standard output, as CSV or as JSON. Times are in milliseconds for the total and in
+nanoseconds for a single run of the operation.
+*/
+void writeResults(bool json)
+{
+	std::cout.setf(std::ios::fixed);
+	std::cout.precision(3);
+
+	if (json)
+	{
+		std::cout << "{\n  \"seed\": " << MAZE_SEED << ",\n  \"results\": [\n";
+		for (int i = 0; i < numResults; ++i)
+		{
+			const BenchmarkResult& result = results[i];
+			std::cout << "    {\"operation\": \"" << result.operation << "\", \"level\": \"" << result.level
+				<< "\", \"size\": " << result.size << ", \"iterations\": " << result.iterations
+				<< ", \"total_ms\": " << result.totalMillis << ", \"ns_per_op\": "
+				<< result.totalMillis * 1000000 / result.iterations << "}" << (i + 1 < numResults ? "," : "") << "\n";
+		}
+		std::cout << "  ]\n}" << std::endl;
+	}
+	else
+	{
+		std::cout << "operation,level,size,iterations,total_ms,ns_per_op\n";
+		for (int i = 0; i < numResults; ++i)
+		{
+			const BenchmarkResult& result = results[i];
+			std::cout << result.operation << "," << result.level << "," << result.size << "," << result.iterations
+				<< "," << result.totalMillis << "," << result.totalMillis * 1000000 / result.iterations << "\n";
+		}
+		std::cout.flush();
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	bool json = false;
+	int maxNodes = MAZE_SIZES[NUM_SIZES - 1];
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--json") == 0)
+			json = true;
+		else if (strcmp(argv[i], "--csv") == 0)
+			json = false;
+		else if (strcmp(argv[i], "--max-nodes") == 0 && i + 1 < argc)
+			maxNodes = atoi(argv[++i]);
+		else
+		{
+			std::cerr << "Usage: " << argv[0] << " [--csv | --json] [--max-nodes N]" << std::endl;
+			return 1;
+		}
+	}
+
+	for (int i = 0; i < NUM_SIZES && MAZE_SIZES[i] <= maxNodes; ++i)
+	{
+		benchmarkLevel<MazeLevelOne>("one", MAZE_SIZES[i], MAZE_SIZES[i] <= MAX_LEVEL_ONE_DISPLAY_NODES);
+		benchmarkLevel<MazeLevelTwo>("two", MAZE_SIZES[i], true);
+	}
+
+	if (!checkSelfPush<Queue<std::string> >(MAX_SELF_PUSH_ITEMS))
+	{
+		std::cerr << "Pushing the front of a queue into it did not push a copy of the front" << std::endl;
+		return 1;
+	}
+	if (!checkSelfPush<Stack<std::string> >(MAX_SELF_PUSH_ITEMS))
+	{
+		std::cerr << "Pushing the top of a stack onto it did not push a copy of the top" << std::endl;
+		return 1;
+	}
+
+	for (int i = 0; i < NUM_SIZES && MAZE_SIZES[i] <= maxNodes; ++i)
+	{
+		benchmarkContainer<Queue<int> >("queue", MAZE_SIZES[i]);
+		benchmarkContainer<Stack<int> >("stack", MAZE_SIZES[i]);
+	}
+
+	writeResults(json);
+	return 0;
+}
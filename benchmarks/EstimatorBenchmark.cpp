@@ -0,0 +1,108 @@
+/*
+Estimates the score and the win rate of every agent with ScoreEstimator, on a Level 1 and a Level 2 maze
+and over generated mazes of both levels, then times the random walk on the Level 2 maze with 1, 2, 4, ...
+workers up to the number of cores, to show how the estimator scales.
+
+Build with "make bench" and run ./estimatorBenchmark [games] [nodes] [workers].
+*/
+
+#include "DepthFirstAgent.h"
+#include "MazeLevelOne.h"
+#include "MazeLevelTwo.h"
+#include "RandomWalkAgent.h"
+#include "ScoreEstimator.h"
+#include "WallFollowerAgent.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+const int DEFAULT_NUM_GAMES = 100000; //Games played by each agent on each maze
+const int DEFAULT_NUM_NODES = 1000; //Number of nodes of the mazes
+const int GAMES_PER_MAZE = 100; //Games played on each generated maze
+const uint64_t MAZE_SEED = 2015; //Mazes and agents are seeded so that runs are comparable
+
+MazeAgent* makeRandomWalk(uint64_t seed)
+{
+	return new RandomWalkAgent(seed);
+}
+
+MazeAgent* makeWallFollower(uint64_t)
+{
+	return new WallFollowerAgent();
+}
+
+MazeAgent* makeDepthFirst(uint64_t)
+{
+	return new DepthFirstAgent();
+}
+
+/*
+Prints one row of the results table.
+*/
+void printRow(const char* maze, const char* agent, const ScoreEstimate& estimate)
+{
+	std::cout << std::setw(9) << maze << std::setw(14) << agent << std::fixed
+		<< std::setw(10) << std::setprecision(1) << estimate.meanScore
+		<< " +/-" << std::setw(7) << estimate.scoreMargin
+		<< std::setw(9) << std::setprecision(4) << estimate.winRate
+		<< " +/-" << std::setw(7) << estimate.winMargin
+		<< std::setw(12) << std::setprecision(0) << estimate.getGamesPerSecond()
+		<< std::setw(8) << estimate.numSteals << std::endl;
+}
+
+/*
+Estimates every agent on the maze, or over generated mazes of the level when mazePtr is NULL, and prints
+a row for each.
+*/
+void runAgents(ScoreEstimator& estimator, const char* name, const MazeInterface* mazePtr, int level, int numNodes,
+		int numGames)
+{
+	const char* agentNames[] = {"random walk", "wall follower", "depth first"};
+	ScoreEstimator::AgentMaker makers[] = {makeRandomWalk, makeWallFollower, makeDepthFirst};
+
+	for (int i = 0; i < 3; ++i)
+	{
+		if (mazePtr)
+			printRow(name, agentNames[i], estimator.estimate(*mazePtr, makers[i], numGames, MAZE_SEED));
+		else
+			printRow(name, agentNames[i], estimator.estimateOverMazes(level, numNodes, numGames / GAMES_PER_MAZE,
+				GAMES_PER_MAZE, makers[i], MAZE_SEED));
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	int numGames = (argc > 1 ? atoi(argv[1]) : DEFAULT_NUM_GAMES);
+	int numNodes = (argc > 2 ? atoi(argv[2]) : DEFAULT_NUM_NODES);
+	ScoreEstimator estimator(argc > 3 ? atoi(argv[3]) : 0);
+
+	std::cout << estimator.getNumWorkers() << " workers, 95% confidence intervals" << std::endl;
+	std::cout << std::setw(9) << "maze" << std::setw(14) << "agent" << std::setw(21) << "score"
+		<< std::setw(20) << "win rate" << std::setw(12) << "games/sec" << std::setw(8) << "steals" << std::endl;
+
+	MazeLevelOne levelOne(numNodes, true, MAZE_SEED);
+	runAgents(estimator, "one", &levelOne, 1, numNodes, numGames);
+	MazeLevelTwo levelTwo(numNodes, MAZE_SEED);
+	runAgents(estimator, "two", &levelTwo, 2, numNodes, numGames);
+	runAgents(estimator, "one, any", NULL, 1, numNodes, numGames);
+	runAgents(estimator, "two, any", NULL, 2, numNodes, numGames);
+
+	std::cout << std::endl << std::setw(9) << "workers" << std::setw(14) << "games/sec" << std::setw(10) << "speedup"
+		<< std::setw(10) << "score" << std::endl;
+	double oneWorkerRate = 0;
+	for (int numWorkers = 1; numWorkers <= estimator.getNumWorkers(); numWorkers *= 2)
+	{
+		ScoreEstimator scaled(numWorkers);
+		ScoreEstimate estimate = scaled.estimate(levelTwo, makeRandomWalk, numGames, MAZE_SEED);
+		if (numWorkers == 1)
+			oneWorkerRate = estimate.getGamesPerSecond();
+
+		std::cout << std::setw(9) << numWorkers << std::fixed << std::setw(14) << std::setprecision(0)
+			<< estimate.getGamesPerSecond() << std::setw(9) << std::setprecision(2)
+			<< estimate.getGamesPerSecond() / oneWorkerRate << "x" << std::setw(10) << std::setprecision(1)
+			<< estimate.meanScore << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,95 @@
+/*
+Benchmark comparing the time the player waits on "Try a new maze" before and after MazeFactory.
+
+Before, newMaze built the replacement maze and then deleted the old one, both on the thread the player
+is waiting on. With the factory, the new maze is taken from the pool and the old one is handed to the
+reclaimer. Between two switches the benchmark waits until the pool has been refilled, standing in for
+the time the player spends in the maze, so that only the switch itself is timed. Level 1 mazes are
+balanced, since a plain BST of this size takes too long to build.
+
+Build with "make bench" and run ./factoryBenchmark.
+*/
+
+#include "MazeFactory.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+const int NUM_SIZES = 3;
+const int MAZE_SIZES[NUM_SIZES] = {10000, 100000, 1000000};
+const int NUM_SWITCHES = 10; //Number of times the maze is replaced, per level and size
+const uint64_t MAZE_SEED = 2015; //Mazes are generated from fixed seeds so that runs are comparable
+
+/*
+Returns the average time in milliseconds of replacing a maze of the given level the way newMaze used to,
+building the new maze and then deleting the old one.
+*/
+double timeSynchronousSwitch(int level, int numNodes)
+{
+	MazeInterface* mazePtr = (level == 1 ? static_cast<MazeInterface*>(new MazeLevelOne(numNodes, true, MAZE_SEED))
+		: new MazeLevelTwo(numNodes, MAZE_SEED));
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 1; i <= NUM_SWITCHES; ++i)
+	{
+		MazeInterface* oldMaze = mazePtr;
+		if (level == 1)
+			mazePtr = new MazeLevelOne(numNodes, true, MAZE_SEED + i);
+		else
+			mazePtr = new MazeLevelTwo(numNodes, MAZE_SEED + i);
+		delete oldMaze;
+	}
+	double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	delete mazePtr;
+	return millis / NUM_SWITCHES;
+}
+
+/*
+Returns the average time in milliseconds of replacing a maze of the given level with the factory.
+*/
+double timeFactorySwitch(MazeFactory& mazeFactory, int level)
+{
+	double totalMillis = 0;
+	MazeInterface* mazePtr = mazeFactory.takeMaze(level);
+	for (int i = 0; i < NUM_SWITCHES; ++i)
+	{
+		while (mazeFactory.getNumReady(level) < DEFAULT_MAZE_POOL_SIZE) //The player is playing the maze
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		MazeInterface* oldMaze = mazePtr;
+		mazePtr = mazeFactory.takeMaze(level);
+		mazeFactory.reclaim(oldMaze);
+		totalMillis += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	mazeFactory.reclaim(mazePtr);
+	return totalMillis / NUM_SWITCHES;
+}
+
+int main()
+{
+	srand(MAZE_SEED); //Seeds the factory
+
+	std::cout << std::setw(7) << "level" << std::setw(10) << "nodes" << std::setw(20) << "build+delete (ms)"
+		<< std::setw(16) << "factory (ms)" << std::endl;
+
+	for (int i = 0; i < NUM_SIZES; ++i)
+	{
+		MazeFactory mazeFactory(MAZE_SIZES[i], MAZE_SIZES[i], DEFAULT_MAZE_POOL_SIZE, DEFAULT_MAZE_FACTORY_WORKERS, true);
+		for (int level = 1; level <= NUM_MAZE_LEVELS; ++level)
+		{
+			double synchronousMillis = timeSynchronousSwitch(level, MAZE_SIZES[i]);
+			double factoryMillis = timeFactorySwitch(mazeFactory, level);
+
+			std::cout << std::setw(7) << (level == 1 ? "one" : "two") << std::setw(10) << MAZE_SIZES[i]
+				<< std::fixed << std::setprecision(3) << std::setw(20) << synchronousMillis
+				<< std::setw(16) << factoryMillis << std::endl;
+		}
+	}
+
+	return 0;
+}
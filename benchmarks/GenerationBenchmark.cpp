@@ -0,0 +1,153 @@
+/*
+Benchmark comparing the sampling done while generating a Level 2 maze before and after the retry loops
+were removed.
+
+Before, pathsFromNode drew numbers between 0 and 4 until one was at most the number of nodes left, and
+connectChildren drew directions until it found one that was not taken yet. Now both draw directly from
+the allowed values (see MazeLevelTwo). Both versions of the sampling are reproduced below, drawing from
+the same generator and building nothing but the node count, so that only the cost of the draws is
+compared. The time to construct the whole maze with the current code is shown alongside.
+
+Build with "make bench" and run ./generationBenchmark.
+*/
+
+#include "MazeLevelTwo.h"
+#include "MazeRandom.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+const int NUM_SIZES = 2;
+const int MAZE_SIZES[NUM_SIZES] = {1000000, 10000000};
+const uint64_t MAZE_SEED = 2015; //Mazes are generated from a fixed seed so that runs are comparable
+const int NUM_DIRECTIONS = LEVEL_TWO_NUM_DIRECTIONS - 1; //Directions out of an intersection, without backwards
+
+/*
+The sampling of the old buildMaze, createNodeArray and connectChildren, including the retry loops.
+@post: numDraws is the number of values drawn from the generator.
+@return: The number of nodes generated.
+*/
+int legacySampling(MazeRandom& random, int numNodes, long long& numDraws)
+{
+	int nodeCount = 1; //The start
+	int parentId = 0;
+	int numPaths;
+	numNodes--;
+	numDraws = 0;
+
+	do //Draw until the start has at least one path
+	{
+		while ((numPaths = random.nextInt(LEVEL_TWO_NUM_DIRECTIONS)) > numNodes)
+			numDraws++;
+		numDraws++;
+	} while (numPaths == 0);
+
+	while (parentId < nodeCount && numNodes > 0)
+	{
+		for (int i = 0; i < numPaths; ++i, --numNodes, ++numDraws) //The prize of each new node
+			random.nextInt(LEVEL_TWO_PRIZE_DIST_SIZE);
+
+		int pathArray[4];
+		for (int numElements = 0; numElements < numPaths; ++numElements)
+		{
+			bool taken;
+			do //Draw directions until one is not taken, checking them with a linear scan
+			{
+				int pathIndex = random.nextInt(NUM_DIRECTIONS) + 1;
+				numDraws++;
+
+				taken = false;
+				for (int j = 0; j < numElements && !taken; ++j)
+					taken = (pathArray[j] == pathIndex);
+				pathArray[numElements] = pathIndex;
+			} while (taken);
+		}
+
+		nodeCount += numPaths;
+		parentId++;
+
+		while ((numPaths = random.nextInt(LEVEL_TWO_NUM_DIRECTIONS)) > numNodes)
+			numDraws++;
+		numDraws++;
+	}
+
+	return nodeCount;
+}
+
+/*
+The sampling of the current buildMaze, pathsFromNode and connectChildren.
+@post: numDraws is the number of values drawn from the generator.
+@return: The number of nodes generated.
+*/
+int directSampling(MazeRandom& random, int numNodes, long long& numDraws)
+{
+	int nodeCount = 1; //The start
+	int parentId = 0;
+	numNodes--;
+
+	int numPaths = 1 + random.nextInt(std::min(NUM_DIRECTIONS, numNodes));
+	numDraws = 1;
+
+	while (parentId < nodeCount && numNodes > 0)
+	{
+		for (int i = 0; i < numPaths; ++i, --numNodes, ++numDraws) //The prize of each new node
+			random.nextInt(LEVEL_TWO_PRIZE_DIST_SIZE);
+
+		int pathArray[4] = {1, 2, 3, 4};
+		for (int i = 0; i < numPaths; ++i, ++numDraws) //Partial Fisher-Yates shuffle
+			std::swap(pathArray[i], pathArray[i + random.nextInt(NUM_DIRECTIONS - i)]);
+
+		nodeCount += numPaths;
+		parentId++;
+
+		numPaths = random.nextInt(std::min(NUM_DIRECTIONS, numNodes) + 1);
+		numDraws++;
+	}
+
+	return nodeCount;
+}
+
+/*
+Returns the time taken by sampling in milliseconds.
+@post: drawsPerNode is the average number of values drawn per node generated.
+*/
+double timeSampling(int (*sampling)(MazeRandom&, int, long long&), int numNodes, double& drawsPerNode)
+{
+	MazeRandom random(MAZE_SEED);
+	long long numDraws;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	int nodeCount = sampling(random, numNodes, numDraws);
+	double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	drawsPerNode = double(numDraws) / nodeCount;
+	return millis;
+}
+
+int main()
+{
+	std::cout << std::setw(10) << "nodes" << std::setw(16) << "retry (ms)" << std::setw(14) << "draws/node"
+		<< std::setw(16) << "direct (ms)" << std::setw(14) << "draws/node" << std::setw(16) << "full build (ms)"
+		<< std::endl;
+
+	for (int i = 0; i < NUM_SIZES; ++i)
+	{
+		double legacyDraws, directDraws;
+		double legacyMillis = timeSampling(legacySampling, MAZE_SIZES[i], legacyDraws);
+		double directMillis = timeSampling(directSampling, MAZE_SIZES[i], directDraws);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		MazeLevelTwo maze(MAZE_SIZES[i], MAZE_SEED);
+		double buildMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		std::cout << std::setw(10) << MAZE_SIZES[i] << std::fixed << std::setprecision(2)
+			<< std::setw(16) << legacyMillis << std::setw(14) << legacyDraws
+			<< std::setw(16) << directMillis << std::setw(14) << directDraws
+			<< std::setw(16) << buildMillis << std::endl;
+	}
+
+	return 0;
+}
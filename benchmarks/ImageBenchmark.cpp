@@ -0,0 +1,126 @@
+/*
+Benchmark comparing the time to generate a maze with the time to load it back from a maze image.
+
+For each level, a maze is generated from a fixed seed and saved. The image is then loaded into another
+maze, which checks it and plays straight from the mapped file. The same random moves are played on both
+mazes with makeMoves to check that the loaded maze is the same maze, and the time of the first moves on
+the loaded maze is shown. The node IDs are not compared, as a saved Level 1 maze is renumbered.
+
+Build with "make bench" and run ./imageBenchmark [nodes]. The images are written to the current
+directory and removed at the end.
+*/
+
+#include "MazeLevelOne.h"
+#include "MazeLevelTwo.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+const int DEFAULT_NUM_NODES = 10000000; //Number of nodes of the mazes
+const int NUM_MOVES = 1000000; //Random moves played on each maze, to compare them
+const uint64_t MAZE_SEED = 2015; //Mazes are generated from a fixed seed so that runs are comparable
+
+/*
+Returns the number of milliseconds since start.
+*/
+double millisSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+Plays NUM_MOVES random moves on the maze, starting over whenever a game ends.
+@post: events holds the result of every move.
+@return: The time taken in milliseconds.
+*/
+double playMoves(MazeInterface* mazePtr, const int* pathIndices, MoveEvent* events)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int movesMade = 0; movesMade < NUM_MOVES; mazePtr->startOver())
+		movesMade += mazePtr->makeMoves(pathIndices + movesMade, NUM_MOVES - movesMade, events + movesMade);
+
+	return millisSince(start);
+}
+
+/*
+Saves builtMaze, loads it into loadedMaze, and prints a row of the results table.
+*/
+template <class MazeType>
+void runLevel(const char* level, const char* fileName, int numNodes, double buildMillis, MazeType& builtMaze,
+		MazeType& loadedMaze)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	bool saved = builtMaze.save(fileName);
+	double saveMillis = millisSince(start);
+
+	start = std::chrono::steady_clock::now();
+	bool loaded = saved && loadedMaze.load(fileName);
+	double loadMillis = millisSince(start);
+
+	if (!loaded)
+	{
+		std::cout << std::setw(7) << level << "  could not save or load " << fileName << std::endl;
+		return;
+	}
+
+	int* pathIndices = new int[NUM_MOVES];
+	MoveEvent* builtEvents = new MoveEvent[NUM_MOVES];
+	MoveEvent* loadedEvents = new MoveEvent[NUM_MOVES];
+	MazeRandom random(MAZE_SEED);
+	for (int i = 0; i < NUM_MOVES; ++i)
+		pathIndices[i] = random.nextInt(builtMaze.getNumPaths());
+
+	Player builtPlayer, loadedPlayer;
+	builtMaze.setPlayer(&builtPlayer);
+	loadedMaze.setPlayer(&loadedPlayer);
+	playMoves(&builtMaze, pathIndices, builtEvents);
+	double playMillis = playMoves(&loadedMaze, pathIndices, loadedEvents);
+
+	bool sameMaze = true;
+	for (int i = 0; i < NUM_MOVES && sameMaze; ++i)
+	{
+		sameMaze = (builtEvents[i].outcome == loadedEvents[i].outcome && builtEvents[i].prize == loadedEvents[i].prize
+			&& builtEvents[i].livesLeft == loadedEvents[i].livesLeft);
+	}
+
+	FILE* file = fopen(fileName, "rb");
+	fseek(file, 0, SEEK_END);
+	double megabytes = ftell(file) / 1048576.0;
+	fclose(file);
+	remove(fileName);
+
+	std::cout << std::setw(7) << level << std::setw(10) << numNodes << std::fixed << std::setprecision(2)
+		<< std::setw(14) << buildMillis << std::setw(12) << saveMillis << std::setw(12) << loadMillis
+		<< std::setw(16) << playMillis << std::setw(12) << megabytes << std::setw(8) << (sameMaze ? "yes" : "NO")
+		<< std::endl;
+
+	delete [] pathIndices;
+	delete [] builtEvents;
+	delete [] loadedEvents;
+}
+
+int main(int argc, char* argv[])
+{
+	int numNodes = (argc > 1 ? atoi(argv[1]) : DEFAULT_NUM_NODES);
+
+	std::cout << std::setw(7) << "level" << std::setw(10) << "nodes" << std::setw(14) << "build (ms)"
+		<< std::setw(12) << "save (ms)" << std::setw(12) << "load (ms)" << std::setw(16) << "1M moves (ms)"
+		<< std::setw(12) << "file (MB)" << std::setw(8) << "same" << std::endl;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	MazeLevelOne builtOne(numNodes, true, MAZE_SEED);
+	double buildMillis = millisSince(start);
+	MazeLevelOne loadedOne;
+	runLevel("one", "levelOne.maze", numNodes, buildMillis, builtOne, loadedOne);
+
+	start = std::chrono::steady_clock::now();
+	MazeLevelTwo builtTwo(numNodes, MAZE_SEED);
+	buildMillis = millisSince(start);
+	MazeLevelTwo loadedTwo;
+	runLevel("two", "levelTwo.maze", numNodes, buildMillis, builtTwo, loadedTwo);
+
+	return 0;
+}
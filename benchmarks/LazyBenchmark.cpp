@@ -0,0 +1,100 @@
+/*
+Compares LazyMaze with the mazes built up front: how long a maze takes to build and how much memory it
+holds for a growing number of nodes, and how fast a random walk plays it, along with the number of
+intersections the walk made the lazy maze generate. The mazes built up front are only built up to
+maxEagerNodes nodes, while the lazy ones go on to a trillion.
+
+Build with "make bench" and run ./lazyBenchmark [moves] [maxEagerNodes].
+*/
+
+#include "LazyMaze.h"
+#include "MazeLevelOne.h"
+#include "MazeLevelTwo.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+const int DEFAULT_NUM_MOVES = 10000000; //Moves made by the random walk on each maze
+const long long DEFAULT_MAX_EAGER_NODES = 10000000; //Largest maze built up front
+const long long MAX_LAZY_NODES = 1000000000000LL; //Largest lazy maze
+const uint64_t MAZE_SEED = 2015; //Mazes and moves are seeded so that runs are comparable
+
+/*
+Returns the number of seconds since start.
+*/
+double getSeconds(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+Makes numMoves random moves in the maze, starting over whenever a game ends, and returns the number of
+moves per second.
+*/
+double timeWalk(MazeInterface& maze, int numMoves)
+{
+	Player player;
+	maze.setPlayer(&player);
+	MazeRandom random(MAZE_SEED);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < numMoves; ++i)
+	{
+		MoveOutcome outcome = maze.makeMove(random.nextInt(maze.getNumPaths())).outcome;
+		if (outcome == MOVE_FINISH || outcome == MOVE_GAME_OVER)
+			maze.startOver();
+	}
+
+	return numMoves / getSeconds(start);
+}
+
+/*
+Prints one row of the table.
+*/
+void printRow(const char* level, const char* kind, long long numNodes, double buildMillis, size_t bytes,
+		double movesPerSecond, long long generated)
+{
+	std::cout << std::setw(7) << level << std::setw(7) << kind << std::setw(16) << numNodes << std::fixed
+		<< std::setw(14) << std::setprecision(3) << buildMillis << std::setw(14) << bytes
+		<< std::setw(14) << std::setprecision(0) << movesPerSecond << std::setw(12) << generated << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	int numMoves = (argc > 1 ? atoi(argv[1]) : DEFAULT_NUM_MOVES);
+	long long maxEagerNodes = (argc > 2 ? atoll(argv[2]) : DEFAULT_MAX_EAGER_NODES);
+
+	std::cout << std::setw(7) << "level" << std::setw(7) << "kind" << std::setw(16) << "nodes"
+		<< std::setw(14) << "build ms" << std::setw(14) << "bytes" << std::setw(14) << "moves/sec"
+		<< std::setw(12) << "generated" << std::endl;
+
+	for (long long numNodes = 10000; numNodes <= MAX_LAZY_NODES; numNodes *= 100)
+	{
+		if (numNodes <= maxEagerNodes)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			MazeLevelOne levelOne(numNodes, true, MAZE_SEED); //Balanced, the plain BST is too slow to build at this size
+			double buildMillis = 1000 * getSeconds(start);
+			printRow("one", "eager", numNodes, buildMillis, levelOne.getArenaBytesUsed(), timeWalk(levelOne, numMoves), numNodes);
+
+			start = std::chrono::steady_clock::now();
+			MazeLevelTwo levelTwo(numNodes, MAZE_SEED);
+			buildMillis = 1000 * getSeconds(start);
+			printRow("two", "eager", numNodes, buildMillis, levelTwo.getBytesUsed(), timeWalk(levelTwo, numMoves), numNodes);
+		}
+
+		for (int level = 1; level <= 2; ++level)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			LazyMaze lazy(level, numNodes, MAZE_SEED);
+			double buildMillis = 1000 * getSeconds(start);
+			double movesPerSecond = timeWalk(lazy, numMoves);
+			printRow(level == 1 ? "one" : "two", "lazy", numNodes, buildMillis, lazy.getBytesUsed(), movesPerSecond,
+				lazy.getNodeIdLimit());
+		}
+	}
+
+	return 0;
+}
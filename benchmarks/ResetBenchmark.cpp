@@ -0,0 +1,175 @@
+/*
+Benchmark comparing startOver(), which only undoes the prizes collected since the last reset, with the
+full-maze walk that resetNodes used to do on every reset.
+
+For each maze size, a player plays a short random session and the maze is then reset. The time of
+startOver() is compared against the old pre-order walk over every node. Since the mazes do not expose
+their nodes, the old walk is reproduced here over a tree of pointer-linked nodes of the same size.
+
+Build with "make bench" and run ./resetBenchmark.
+*/
+
+#include "MazeLevelOne.h"
+#include "MazeLevelTwo.h"
+#include "FixedMazeNode.h"
+#include "NodeArena.h"
+#include "Queue.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+const int NUM_SIZES = 4;
+const int MAZE_SIZES[NUM_SIZES] = {1000, 10000, 100000, 1000000};
+const int NUM_RESETS = 20; //Number of sessions played (and resets timed) per maze
+const int MOVES_PER_SESSION = 200; //Random moves played before each reset
+const uint64_t MAZE_SEED = 2015; //Mazes are generated from a fixed seed so that runs are comparable
+
+/*
+Pointer-linked node like the ones the mazes were made of when resetNodes walked the whole maze.
+*/
+template <int NUM_PATHS>
+class LegacyNode : public FixedMazeNode<LegacyNode<NUM_PATHS>*, NUM_PATHS>
+{
+public:
+	LegacyNode(int prizeCode = 0) : FixedMazeNode<LegacyNode<NUM_PATHS>*, NUM_PATHS>(prizeCode) {}
+};
+
+/*
+Plays MOVES_PER_SESSION random moves in the maze, or until the player reaches the finish or runs out
+of lives.
+@return: The number of prizes the player collected during the session.
+*/
+int playSession(MazeInterface* mazePtr)
+{
+	int pathIndices[MOVES_PER_SESSION];
+	MoveEvent events[MOVES_PER_SESSION];
+	for (int i = 0; i < MOVES_PER_SESSION; ++i)
+		pathIndices[i] = rand() % mazePtr->getNumPaths();
+
+	int prizes = 0;
+	int movesMade = mazePtr->makeMoves(pathIndices, MOVES_PER_SESSION, events); //Stops at the finish or game over
+	for (int i = 0; i < movesMade; ++i)
+		prizes += (events[i].prize > 0);
+	return prizes;
+}
+
+/*
+Returns the average time of startOver() in nanoseconds, each reset being preceded by a session.
+@post: totalPrizes is the number of prizes collected over all of the sessions.
+*/
+double timeStartOver(MazeInterface* mazePtr, Player* playerPtr, int& totalPrizes)
+{
+	double totalNanos = 0;
+	totalPrizes = 0;
+	mazePtr->setPlayer(playerPtr);
+	for (int i = 0; i < NUM_RESETS; ++i)
+	{
+		totalPrizes += playSession(mazePtr);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		mazePtr->startOver();
+		totalNanos += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	return totalNanos / NUM_RESETS;
+}
+
+/*
+Builds a tree of numNodes nodes breadth first, giving every node between 1 and NUM_PATHS - 1 children
+until enough nodes have been created. Path index 0 is left as the backwards direction.
+*/
+template <class NodeType, int NUM_PATHS>
+NodeType* buildLegacyTree(NodeArena<NodeType>& nodeArena, int numNodes)
+{
+	NodeType* rootPtr = nodeArena.create(0);
+	Queue<NodeType*> nodeQueue;
+	nodeQueue.push(rootPtr);
+	numNodes--;
+
+	while (numNodes > 0)
+	{
+		NodeType* nodePtr = nodeQueue.front();
+		nodeQueue.pop();
+
+		int numChildren = 1 + rand() % (NUM_PATHS - 1);
+		for (int i = 1; i <= numChildren && numNodes > 0; ++i, --numNodes)
+		{
+			NodeType* childPtr = nodeArena.create(rand() % 3);
+			childPtr->setNextNodePtr(0, nodePtr);
+			nodePtr->setNextNodePtr(i, childPtr);
+			nodeQueue.push(childPtr);
+		}
+	}
+
+	return rootPtr;
+}
+
+/*
+The pre-order walk that resetNodes used to do on every reset, visiting every node of the maze.
+*/
+template <class NodeType, int NUM_PATHS>
+void legacyResetNodes(NodeType* nodePtr)
+{
+	if (nodePtr)
+	{
+		nodePtr->resetPrize();
+		for (int i = 1; i < NUM_PATHS; ++i)
+			legacyResetNodes<NodeType, NUM_PATHS>(nodePtr->getNextNodePtr(i));
+	}
+}
+
+/*
+Returns the average time of the legacy walk in nanoseconds, over a tree of numNodes nodes.
+*/
+template <class NodeType, int NUM_PATHS>
+double timeLegacyReset(int numNodes)
+{
+	NodeArena<NodeType> nodeArena;
+	NodeType* rootPtr = buildLegacyTree<NodeType, NUM_PATHS>(nodeArena, numNodes);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < NUM_RESETS; ++i)
+		legacyResetNodes<NodeType, NUM_PATHS>(rootPtr);
+
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / NUM_RESETS;
+}
+
+/*
+Prints one row of the results table.
+*/
+void printRow(const char* level, int numNodes, int totalPrizes, double startOverNanos, double legacyNanos)
+{
+	std::cout << std::setw(7) << level << std::setw(10) << numNodes
+		<< std::setw(16) << std::fixed << std::setprecision(1) << double(totalPrizes) / NUM_RESETS
+		<< std::setw(18) << startOverNanos << std::setw(18) << legacyNanos
+		<< std::setw(12) << legacyNanos / startOverNanos << "x" << std::endl;
+}
+
+int main()
+{
+	srand(MAZE_SEED); //The moves of the sessions are replayed too
+
+	std::cout << std::setw(7) << "level" << std::setw(10) << "nodes" << std::setw(16) << "prizes/reset"
+		<< std::setw(18) << "startOver (ns)" << std::setw(18) << "full walk (ns)"
+		<< std::setw(13) << "speedup" << std::endl;
+
+	for (int i = 0; i < NUM_SIZES; ++i)
+	{
+		Player player;
+		int totalPrizes;
+
+		MazeLevelOne levelOne(MAZE_SIZES[i], true, MAZE_SEED); //Balanced, the plain BST is too slow to build at this size
+		double startOverNanos = timeStartOver(&levelOne, &player, totalPrizes);
+		double legacyNanos = timeLegacyReset<LegacyNode<LEVEL_ONE_NUM_DIRECTIONS>, LEVEL_ONE_NUM_DIRECTIONS>(MAZE_SIZES[i]);
+		printRow("one", MAZE_SIZES[i], totalPrizes, startOverNanos, legacyNanos);
+
+		MazeLevelTwo levelTwo(MAZE_SIZES[i], MAZE_SEED);
+		startOverNanos = timeStartOver(&levelTwo, &player, totalPrizes);
+		legacyNanos = timeLegacyReset<LegacyNode<LEVEL_TWO_NUM_DIRECTIONS>, LEVEL_TWO_NUM_DIRECTIONS>(MAZE_SIZES[i]);
+		printRow("two", MAZE_SIZES[i], totalPrizes, startOverNanos, legacyNanos);
+	}
+
+	return 0;
+}
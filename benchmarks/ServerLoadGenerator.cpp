@@ -0,0 +1,263 @@
+/*
+Load generator for MazeServer, reporting the latency of its commands as seen by the clients.
+
+Many clients connect at once, and each of them plays its own game with one command in flight at a time:
+it asks for a maze, then mostly moves in random directions, reveals now and then, starts over when the
+game ends and asks for a new maze every NEW_MAZE_PERIOD commands. The time from sending a command to
+receiving its reply is recorded for every command, and the median (p50) and 99th percentile (p99) are
+shown along with the throughput. All of the clients run on one thread, driven by epoll like the server.
+
+Build with "make bench" and run
+	./serverLoadGenerator [clients] [commands per client] [socket path]
+Without a socket path, a server is started in this process, on its own thread, with mazes of
+LEVEL_ONE_NODES and LEVEL_TWO_NODES nodes. Otherwise, start the server first with
+	./a.out --server <socket path> [Level 1 nodes] [Level 2 nodes]
+*/
+
+#include "MazeServer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+const int DEFAULT_NUM_CLIENTS = 1000;
+const int DEFAULT_COMMANDS_PER_CLIENT = 200;
+const int LEVEL_ONE_NODES = 1000; //Nodes of the mazes of the server started here
+const int LEVEL_TWO_NODES = 10000;
+const int NEW_MAZE_PERIOD = 100; //A client asks for a new maze every NEW_MAZE_PERIOD commands
+const int REVEAL_PERIOD = 10; //and reveals every REVEAL_PERIOD commands
+const uint64_t CLIENT_SEED = 2015; //The clients draw their moves from fixed seeds so that runs are comparable
+
+/*
+One simulated player: their socket, their game and the command waiting for its reply.
+*/
+struct Client
+{
+	int socket;
+	int level;
+	int numPaths; //Paths the client can take in its maze, known once the server gave it one
+	int commandsSent;
+	bool mustStartOver; //Set when the last move ended the game
+	MazeRandom random;
+	std::chrono::steady_clock::time_point sentAt; //When the command in flight was sent
+	char input[MAX_REPLY_LENGTH];
+	int inputLength;
+};
+
+/*
+Sends the next command of the client, according to its game.
+@return: False if the command could not be sent.
+*/
+bool sendCommand(Client& client)
+{
+	char command[MAX_COMMAND_LENGTH];
+	int commandLength;
+	if (client.commandsSent % NEW_MAZE_PERIOD == 0)
+		commandLength = snprintf(command, sizeof(command), "N %d\n", client.level);
+	else if (client.mustStartOver)
+		commandLength = snprintf(command, sizeof(command), "S\n");
+	else if (client.commandsSent % REVEAL_PERIOD == 0)
+		commandLength = snprintf(command, sizeof(command), "R\n");
+	else
+		commandLength = snprintf(command, sizeof(command), "M %d\n", client.random.nextInt(client.numPaths));
+
+	client.mustStartOver = false;
+	client.commandsSent++;
+	client.sentAt = std::chrono::steady_clock::now();
+	return (send(client.socket, command, commandLength, MSG_NOSIGNAL) == commandLength);
+}
+
+/*
+Reads the reply of the server to a command of the client, and updates its game.
+@return: False if the reply is an error.
+*/
+bool readReply(Client& client, const char* reply)
+{
+	if (reply[0] == 'N')
+		sscanf(reply, "N %*d %d", &client.numPaths);
+	else if (reply[0] == 'M')
+	{
+		int outcome = MOVE_INVALID;
+		sscanf(reply, "M %d", &outcome);
+		client.mustStartOver = (outcome == MOVE_FINISH || outcome == MOVE_GAME_OVER);
+	}
+
+	return (reply[0] != 'E');
+}
+
+/*
+Connects numClients clients to the server and plays commandsPerClient commands with each of them.
+@post: latencies holds the latency of every command, in nanoseconds.
+@return: The number of commands that got a reply, or -1 if the clients could not connect.
+*/
+long long runClients(const char* socketPath, int numClients, int commandsPerClient, long long* latencies)
+{
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strncpy(address.sun_path, socketPath, sizeof(address.sun_path) - 1);
+
+	int epollFd = epoll_create1(0);
+	Client* clients = new Client[numClients];
+	int numConnected = 0;
+	for (int i = 0; i < numClients; ++i)
+	{
+		clients[i].socket = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (clients[i].socket < 0 || connect(clients[i].socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+		{
+			std::cerr << "Could not connect client " << i << " to " << socketPath << std::endl;
+			if (clients[i].socket >= 0) //The socket was created, but could not connect
+				close(clients[i].socket);
+			break;
+		}
+		fcntl(clients[i].socket, F_SETFL, O_NONBLOCK);
+		numConnected++;
+
+		clients[i].level = 1 + i % 2; //Half of the clients play each level
+		clients[i].numPaths = 1;
+		clients[i].commandsSent = 0;
+		clients[i].mustStartOver = false;
+		clients[i].random.setSeed(CLIENT_SEED + i);
+		clients[i].inputLength = 0;
+
+		epoll_event event;
+		event.events = EPOLLIN;
+		event.data.ptr = &clients[i];
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, clients[i].socket, &event);
+	}
+
+	long long numReplies = -1;
+	if (numConnected == numClients)
+	{
+		numReplies = 0;
+		for (int i = 0; i < numClients; ++i)
+			sendCommand(clients[i]);
+
+		int numPlaying = numClients;
+		epoll_event events[SERVER_MAX_EVENTS];
+		while (numPlaying > 0)
+		{
+			int numEvents = epoll_wait(epollFd, events, SERVER_MAX_EVENTS, -1);
+			for (int i = 0; i < numEvents; ++i)
+			{
+				Client& client = *static_cast<Client*>(events[i].data.ptr);
+				ssize_t numRead = recv(client.socket, client.input + client.inputLength,
+					MAX_REPLY_LENGTH - 1 - client.inputLength, 0);
+				if (numRead < 0 && errno == EAGAIN) //Woken up with nothing to read
+					continue;
+				if (numRead <= 0)
+				{
+					std::cerr << "Client " << (&client - clients) << " lost its connection" << std::endl;
+					close(client.socket);
+					numPlaying--;
+					continue;
+				}
+
+				char* lineEnd = static_cast<char*>(memchr(client.input + client.inputLength, '\n', numRead));
+				client.inputLength += numRead;
+				if (!lineEnd) //Only part of the reply arrived
+					continue;
+
+				//One command is in flight at a time, so this is its whole reply
+				latencies[numReplies++] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now() - client.sentAt).count();
+				*lineEnd = '\0';
+				client.inputLength = 0;
+
+				bool isPlaying = readReply(client, client.input);
+				if (!isPlaying)
+					std::cerr << "Client " << (&client - clients) << " got an error: " << client.input << std::endl;
+				else if (client.commandsSent < commandsPerClient)
+					isPlaying = sendCommand(client);
+				else //This client is done
+					isPlaying = false;
+
+				if (!isPlaying)
+				{
+					close(client.socket);
+					numPlaying--;
+				}
+			}
+		}
+	}
+	else
+	{
+		for (int i = 0; i < numConnected; ++i)
+			close(clients[i].socket);
+	}
+
+	close(epollFd);
+	delete [] clients;
+	return numReplies;
+}
+
+int main(int argc, char* argv[])
+{
+	int numClients = (argc > 1 ? atoi(argv[1]) : DEFAULT_NUM_CLIENTS);
+	int commandsPerClient = (argc > 2 ? atoi(argv[2]) : DEFAULT_COMMANDS_PER_CLIENT);
+	if (numClients < 1 || commandsPerClient < 1)
+	{
+		std::cerr << "Usage: " << argv[0] << " [clients] [commands per client] [socket path]" << std::endl;
+		return 1;
+	}
+
+	char socketPath[64];
+	MazeLibrary* mazeLibrary = NULL;
+	MazeServer* server = NULL;
+	std::thread serverThread;
+	if (argc > 3)
+		strncpy(socketPath, argv[3], sizeof(socketPath) - 1);
+	else //Start our own server
+	{
+		snprintf(socketPath, sizeof(socketPath), "/tmp/mazeLoadGenerator.%d.sock", int(getpid()));
+		srand(CLIENT_SEED);
+		mazeLibrary = new MazeLibrary(LEVEL_ONE_NODES, LEVEL_TWO_NODES, DEFAULT_LIBRARY_MAZES, true);
+		server = new MazeServer(*mazeLibrary);
+		if (!server->listen(socketPath))
+		{
+			std::cerr << "Could not listen on " << socketPath << std::endl;
+			return 1;
+		}
+		serverThread = std::thread(&MazeServer::run, server);
+	}
+	socketPath[sizeof(socketPath) - 1] = '\0';
+
+	long long* latencies = new long long[static_cast<long long>(numClients) * commandsPerClient];
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	long long numReplies = runClients(socketPath, numClients, commandsPerClient, latencies);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (server)
+	{
+		server->stop();
+		serverThread.join();
+		delete server;
+		delete mazeLibrary;
+	}
+
+	if (numReplies > 0)
+	{
+		std::sort(latencies, latencies + numReplies);
+		std::cout << std::fixed << std::setprecision(1);
+		std::cout << "clients: " << numClients << ", commands: " << numReplies << ", time: " << seconds << " s, "
+			<< numReplies / seconds << " commands/s" << std::endl;
+		std::cout << "latency (us): p50 " << latencies[numReplies / 2] / 1000.0
+			<< ", p99 " << latencies[numReplies * 99 / 100] / 1000.0
+			<< ", max " << latencies[numReplies - 1] / 1000.0 << std::endl;
+	}
+
+	delete [] latencies;
+	return (numReplies > 0 ? 0 : 1);
+}
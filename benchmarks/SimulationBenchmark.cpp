@@ -0,0 +1,68 @@
+/*
+Runs every agent on a Level 1 and a Level 2 maze with the headless SimulationEngine, and reports how
+fast the games are played and how well each agent does.
+
+Build with "make bench" and run ./simulationBenchmark [games] [nodes].
+*/
+
+#include "DepthFirstAgent.h"
+#include "MazeLevelOne.h"
+#include "MazeLevelTwo.h"
+#include "RandomWalkAgent.h"
+#include "SimulationEngine.h"
+#include "WallFollowerAgent.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+const int DEFAULT_NUM_GAMES = 100000; //Games played by each agent on each maze
+const int DEFAULT_NUM_NODES = 1000; //Number of nodes of the mazes
+const uint64_t MAZE_SEED = 2015; //Mazes and agents are seeded so that runs are comparable
+
+/*
+Prints one row of the results table.
+*/
+void printRow(const char* level, const char* agent, const SimulationStats& stats)
+{
+	std::cout << std::setw(7) << level << std::setw(14) << agent << std::fixed
+		<< std::setw(14) << std::setprecision(0) << stats.getGamesPerSecond()
+		<< std::setw(14) << stats.getMovesPerSecond()
+		<< std::setw(10) << std::setprecision(3) << stats.getWinRate()
+		<< std::setw(12) << stats.getLifeLossRate()
+		<< std::setw(12) << std::setprecision(2) << stats.getLivesLostPerGame()
+		<< std::setw(12) << stats.numAbandoned << std::endl;
+}
+
+/*
+Plays every agent on the maze and prints a row for each.
+*/
+void runAgents(const char* level, MazeInterface* mazePtr, int numGames)
+{
+	SimulationEngine engine;
+	RandomWalkAgent randomWalk(MAZE_SEED);
+	WallFollowerAgent wallFollower;
+	DepthFirstAgent depthFirst;
+
+	printRow(level, "random walk", engine.run(mazePtr, &randomWalk, numGames));
+	printRow(level, "wall follower", engine.run(mazePtr, &wallFollower, numGames));
+	printRow(level, "depth first", engine.run(mazePtr, &depthFirst, numGames));
+}
+
+int main(int argc, char* argv[])
+{
+	int numGames = (argc > 1 ? atoi(argv[1]) : DEFAULT_NUM_GAMES);
+	int numNodes = (argc > 2 ? atoi(argv[2]) : DEFAULT_NUM_NODES);
+
+	std::cout << std::setw(7) << "level" << std::setw(14) << "agent" << std::setw(14) << "games/sec"
+		<< std::setw(14) << "moves/sec" << std::setw(10) << "win rate" << std::setw(12) << "life loss"
+		<< std::setw(12) << "lives/game" << std::setw(12) << "abandoned" << std::endl;
+
+	MazeLevelOne levelOne(numNodes, true, MAZE_SEED);
+	runAgents("one", &levelOne, numGames);
+
+	MazeLevelTwo levelTwo(numNodes, MAZE_SEED);
+	runAgents("two", &levelTwo, numGames);
+
+	return 0;
+}
@@ -1,8 +1,11 @@
 #include <iostream>
 #include <iomanip>
+#include <cstring>
 
+#include "MazeFactory.h"
 #include "MazeLevelOne.h"
 #include "MazeLevelTwo.h"
+#include "MazeServer.h"
 
 /*
 Author: Enis K Inan
@@ -88,11 +91,12 @@ to the game via displayMazeInfo, and then they are given 6 options to choose fro
 Depending on the choice, the program moves to the functions movePlayer (for 0), startOver (for 1),
 newMaze (for 2), displayMaze (for 3), or back to main() (4).
 
-@param: userChoice: 0 = Level 1, 1 = Level 2
+@param: mazeFactory: Hands out the mazes, and deletes them once they are given back
+userChoice: 0 = Level 1, 1 = Level 2
 
 @return Returns the player's total score for the games they playe if they exit back to the main menu.
 */
-int playGame(int userChoice);
+int playGame(MazeFactory& mazeFactory, int userChoice);
 
 /*
 Welcomes the player to the game and displays information about the maze
@@ -125,9 +129,10 @@ function of the maze object.
 void startOver(MazeInterface* mazePtr);
 
 /*
-Creates a new maze object.
+Replaces the maze with a new maze of the same level, taken from mazeFactory. The old maze is given back
+to mazeFactory, which deletes it in the background.
 */
-void newMaze(MazeInterface* &mazePtr);
+void newMaze(MazeFactory& mazeFactory, MazeInterface* &mazePtr);
 
 /*
 Handles the case of game over, is called when movePlayer returns -2 to playGame.
@@ -136,11 +141,25 @@ Player can either 0) Start over, (1) Try a new maze, or (2) exit the game.
 @return Returns the action taken by the player. -1 if they started a new game, 0 if they started over,
 or 1 if they chose to quit the game.
 */
-int gameOver(MazeInterface* &mazePtr);
+int gameOver(MazeFactory& mazeFactory, MazeInterface* &mazePtr);
 
-int main()
+/*
+Runs the game as a server instead, until it is interrupted (Ctrl-C) or terminated. Clients connect to
+the Unix domain socket at socketPath and play with the commands described in MazeSession. Every new
+maze is one of the mazes of a MazeLibrary built at startup, with the given numbers of nodes, which is
+shared with the other clients.
+
+@return: 0 once the server has stopped, or 1 if it could not listen on socketPath.
+*/
+int runServer(const char* socketPath, int levelOneNodes, int levelTwoNodes);
+
+int main(int argc, char* argv[])
 {
 	srand(time(0));
+	if (argc >= 3 && strcmp(argv[1], "--server") == 0) //./a.out --server <socket path> [Level 1 nodes] [Level 2 nodes]
+		return runServer(argv[2], (argc > 3 ? atoi(argv[3]) : MAZE_NODES_ONE), (argc > 4 ? atoi(argv[4]) : MAZE_NODES_TWO));
+
+	MazeFactory mazeFactory(MAZE_NODES_ONE, MAZE_NODES_TWO); //Seeded from rand(), so created after srand
 	int userChoice;
 
 	//Create the options array for input handler
@@ -157,7 +176,7 @@ int main()
 
 		if (userChoice != (NUM_OPTIONS - 1)) //Means that they want to play the game
 		{
-			playerScore = playGame(userChoice); //Take them to the menu to do that
+			playerScore = playGame(mazeFactory, userChoice); //Take them to the menu to do that
 			system("clear");
 			cout << "Your final score for the level(s) you played: " << playerScore << endl << endl;
 			pause();
@@ -217,7 +236,7 @@ bool isValidChoice(int userChoice, int numOptions)
 	return ((0 <= userChoice) && (userChoice < numOptions));
 }
 
-int playGame(int userChoice)
+int playGame(MazeFactory& mazeFactory, int userChoice)
 {
 	int controlVar;
 	int userScore = 0;
@@ -230,11 +249,7 @@ int playGame(int userChoice)
 	Player* newPlayer = getPlayerInfo();
 	system("clear");
 
-	MazeInterface* mazePtr = NULL;
-	if (userChoice)
-		mazePtr = new MazeLevelTwo(MAZE_NODES_TWO);
-	else
-		mazePtr = new MazeLevelOne(MAZE_NODES_ONE);
+	MazeInterface* mazePtr = mazeFactory.takeMaze(userChoice + 1); //Level 1 or 2
 	mazePtr->setPlayer(newPlayer);
 
 
@@ -266,7 +281,7 @@ int playGame(int userChoice)
 				}
 				else if (controlVar == -2) //Game over, player's out of lives
 				{
-					controlVar = gameOver(mazePtr); //Check what player wants to do next
+					controlVar = gameOver(mazeFactory, mazePtr); //Check what player wants to do next
 					if (controlVar == 1) //Player wants to quit
 						controlVar = NUM_OPTIONS - 1;
 					else if (controlVar == -1) //New game was started
@@ -282,7 +297,7 @@ int playGame(int userChoice)
 				pause();
 				break;
 			case 2: //Player wants to start a new maze
-				newMaze(mazePtr);
+				newMaze(mazeFactory, mazePtr);
 				newPlayer->resetNumItems();
 				mazePtr->setPlayer(newPlayer);
 				pause();
@@ -298,8 +313,8 @@ int playGame(int userChoice)
 
 	} while (controlVar != NUM_OPTIONS - 1);
 
-	delete newPlayer; //Deallocate the player and maze memory
-	delete mazePtr;
+	delete newPlayer; //Deallocate the player, and give the maze back to be deleted
+	mazeFactory.reclaim(mazePtr);
 
 	return userScore;
 }
@@ -381,24 +396,24 @@ void startOver(MazeInterface* mazePtr)
 	cout << "Done! You are back at the beginning of the maze." << endl << endl;
 }
 
-void newMaze(MazeInterface* &mazePtr)
+void newMaze(MazeFactory& mazeFactory, MazeInterface* &mazePtr)
 {
 	MazeInterface* oldMaze = mazePtr;
 
 	cout << "Creating a new maze.." << endl;
 
 	if (dynamic_cast<MazeLevelOne*>(oldMaze))
-		mazePtr = new MazeLevelOne(MAZE_NODES_ONE);
+		mazePtr = mazeFactory.takeMaze(1);
 	else //It is Level 2
-		mazePtr = new MazeLevelTwo(MAZE_NODES_TWO);
+		mazePtr = mazeFactory.takeMaze(2);
 
-	delete oldMaze;
+	mazeFactory.reclaim(oldMaze); //Deleted in the background
 
 	cout <<"Done!" << endl;
 }
 
 
-int gameOver(MazeInterface* &mazePtr)
+int gameOver(MazeFactory& mazeFactory, MazeInterface* &mazePtr)
 {
 	system("clear");
 
@@ -422,7 +437,7 @@ int gameOver(MazeInterface* &mazePtr)
 			break;
 		case 1: //1 = user wants to try a new maze
 			returnVal = -1;
-			newMaze(mazePtr);
+			newMaze(mazeFactory, mazePtr);
 			pause();
 			break;
 		default: //User wants to exit the game
@@ -463,3 +478,21 @@ Player* getPlayerInfo()
 
 	return temp;
 }
+
+int runServer(const char* socketPath, int levelOneNodes, int levelTwoNodes)
+{
+	MazeLibrary mazeLibrary(levelOneNodes, levelTwoNodes, DEFAULT_LIBRARY_MAZES, true); //Balanced, since Level 1
+	MazeServer server(mazeLibrary);								//mazes may be large here
+	if (!server.listen(socketPath))
+	{
+		cout << "Could not listen on " << socketPath << endl;
+		return 1;
+	}
+
+	server.stopOnSignals();
+	cout << "Serving mazes on " << socketPath << ", press Ctrl-C to stop." << endl;
+	server.run();
+	cout << "Server stopped." << endl;
+
+	return 0;
+}